@@ -217,13 +217,12 @@ define_pd_global(bool, ThreadLocalHandshakes, false);
   diagnostic(bool, UseLibmIntrinsic, true,                                  \
           "Use Libm Intrinsics")                                            \
                                                                             \
-  /* Minimum array size in bytes to use AVX512 intrinsics */                \
-  /* for copy, inflate and fill which don't bail out early based on any */  \
-  /* condition. When this value is set to zero compare operations like */   \
-  /* compare, vectorizedMismatch, compress can also use AVX512 intrinsics.*/\
+  /* Minimum array size in bytes to use AVX512 intrinsics. Shorter */       \
+  /* arrays are processed with AVX2 which doesn't lower the clock. */       \
+  /* When this value is set to zero AVX512 is used for all sizes. */        \
   diagnostic(int, AVX3Threshold, 4096,                                      \
-             "Minimum array size in bytes to use AVX512 intrinsics"         \
-             "for copy, inflate and fill. When this value is set as zero"   \
-             "compare operations can also use AVX512 intrinsics.")          \
+             "Minimum array size in bytes to use AVX512 intrinsics "        \
+             "for copy, inflate, fill, compress, compare and "              \
+             "hasNegatives. Zero means AVX512 is used for all sizes.")      \
           range(0, max_jint)
 #endif // CPU_X86_VM_GLOBALS_X86_HPP
@@ -6769,11 +6769,16 @@ void MacroAssembler::string_compare(Register str1, Register str2,
     bind(COMPARE_WIDE_VECTORS_LOOP);
 
 #ifdef _LP64
-    if ((AVX3Threshold == 0) && VM_Version::supports_avx512vlbw()) { // trying 64 bytes fast loop
+    if (VM_Version::supports_avx512vlbw()) { // trying 64 bytes fast loop
       cmpl(cnt2, stride2x2);
       jccb(Assembler::below, COMPARE_WIDE_VECTORS_LOOP_AVX2);
       testl(cnt2, stride2x2-1);   // cnt2 holds the vector count
       jccb(Assembler::notZero, COMPARE_WIDE_VECTORS_LOOP_AVX2);   // means we cannot subtract by 0x40
+      if (AVX3Threshold != 0) {
+        // only long strings are worth the AVX512 frequency penalty
+        cmpl(cnt2, (ae == StrIntrinsicNode::LL) ? AVX3Threshold : AVX3Threshold / 2);
+        jccb(Assembler::below, COMPARE_WIDE_VECTORS_LOOP_AVX2);
+      }
 
       bind(COMPARE_WIDE_VECTORS_LOOP_AVX3); // the hottest loop
       if (ae == StrIntrinsicNode::LL || ae == StrIntrinsicNode::UU) {
@@ -7024,18 +7029,26 @@ void MacroAssembler::has_negatives(Register ary1, Register len,
   assert_different_registers(ary1, len, result, tmp1);
   assert_different_registers(vec1, vec2);
   Label TRUE_LABEL, FALSE_LABEL, DONE, COMPARE_CHAR, COMPARE_VECTORS, COMPARE_BYTE;
+  Label below_avx3_threshold;
 
   // len == 0
   testl(len, len);
   jcc(Assembler::zero, FALSE_LABEL);
 
-  if ((AVX3Threshold == 0) && (UseAVX > 2) && // AVX512
+  bool use_avx3 = (UseAVX > 2) && // AVX512
     VM_Version::supports_avx512vlbw() &&
-    VM_Version::supports_bmi2()) {
+    VM_Version::supports_bmi2();
+  if (use_avx3) {
 
     Label test_64_loop, test_tail;
     Register tmp3_aliased = len;
 
+    if (AVX3Threshold != 0) {
+      // only long arrays are worth the AVX512 frequency penalty
+      cmpl(len, AVX3Threshold);
+      jcc(Assembler::below, below_avx3_threshold);
+    }
+
     movl(tmp1, len);
     vpxor(vec2, vec2, vec2, Assembler::AVX_512bit);
 
@@ -7099,7 +7112,9 @@ void MacroAssembler::has_negatives(Register ary1, Register len,
     jcc(Assembler::notZero, TRUE_LABEL);
 
     jmp(FALSE_LABEL);
-  } else {
+  }
+  if (!use_avx3 || AVX3Threshold != 0) {
+    bind(below_avx3_threshold);
     movl(result, len); // copy
 
     if (UseAVX >= 2 && UseSSE >= 2) {
@@ -7276,11 +7291,16 @@ void MacroAssembler::arrays_equals(bool is_array_equ, Register ary1, Register ar
     negptr(limit);
 
 #ifdef _LP64
-    if ((AVX3Threshold == 0) && VM_Version::supports_avx512vlbw()) { // trying 64 bytes fast loop
+    if (VM_Version::supports_avx512vlbw()) { // trying 64 bytes fast loop
       Label COMPARE_WIDE_VECTORS_LOOP_AVX2, COMPARE_WIDE_VECTORS_LOOP_AVX3;
 
       cmpl(limit, -64);
       jcc(Assembler::greater, COMPARE_WIDE_VECTORS_LOOP_AVX2);
+      if (AVX3Threshold != 0) {
+        // only long arrays are worth the AVX512 frequency penalty
+        cmpl(limit, -AVX3Threshold);
+        jcc(Assembler::greater, COMPARE_WIDE_VECTORS_LOOP_AVX2);
+      }
 
       bind(COMPARE_WIDE_VECTORS_LOOP_AVX3); // the hottest loop
 
@@ -8277,9 +8297,10 @@ void MacroAssembler::vectorized_mismatch(Register obja, Register objb, Register
   shlq(length);
   xorq(result, result);
 
-  if ((AVX3Threshold == 0) && (UseAVX > 2) &&
+  if ((UseAVX > 2) &&
       VM_Version::supports_avx512vlbw()) {
-    cmpq(length, 64);
+    // only long arrays are worth the AVX512 frequency penalty
+    cmpq(length, MAX2(64, (int)AVX3Threshold));
     jcc(Assembler::less, VECTOR32_TAIL);
 
     movq(tmp1, length);
@@ -10065,7 +10086,7 @@ void MacroAssembler::char_array_compress(Register src, Register dst, Register le
   // save length for return
   push(len);
 
-  if ((AVX3Threshold == 0) && (UseAVX > 2) && // AVX512
+  if ((UseAVX > 2) && // AVX512
     VM_Version::supports_avx512vlbw() &&
     VM_Version::supports_bmi2()) {
 
@@ -10078,6 +10099,13 @@ void MacroAssembler::char_array_compress(Register src, Register dst, Register le
     testl(len, -32);
     jcc(Assembler::zero, below_threshold);
 
+    if (AVX3Threshold != 0) {
+      // only long strings are worth the AVX512 frequency penalty
+      // (len is in chars)
+      cmpl(len, AVX3Threshold / 2);
+      jcc(Assembler::below, below_threshold);
+    }
+
     // First check whether a character is compressable ( <= 0xFF).
     // Create mask to test for Unicode chars inside zmm vector
     movl(result, 0x00FF);
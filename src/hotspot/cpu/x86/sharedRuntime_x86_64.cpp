@@ -1891,6 +1891,13 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
   }
   assert(native_func != NULL, "must have function");
 
+  // A trivial native is called without leaving _thread_in_Java: no
+  // safepoint can happen during the call so array arguments can't move
+  // and need no GC locker. That doesn't hold with a GC that moves
+  // objects concurrently so those call it as a regular critical native.
+  bool is_trivial_native = is_critical_native && method->is_trivial_native()
+                           SHENANDOAHGC_ONLY(&& !UseShenandoahGC) ZGC_ONLY(&& !UseZGC);
+
   // An OopMap for lock (and class if static)
   OopMapSet *oop_maps = new OopMapSet();
   intptr_t start = (intptr_t)__ pc();
@@ -2154,7 +2161,7 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
 
   const Register oop_handle_reg = r14;
 
-  if (is_critical_native SHENANDOAHGC_ONLY(&& !UseShenandoahGC)) {
+  if (is_critical_native && !is_trivial_native SHENANDOAHGC_ONLY(&& !UseShenandoahGC)) {
     check_needs_gc_for_critical_native(masm, stack_slots, total_c_args, total_in_args,
                                        oop_handle_offset, oop_maps, in_regs, in_sig_bt);
   }
@@ -2462,7 +2469,9 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
   }
 
   // Now set thread in native
-  __ movl(Address(r15_thread, JavaThread::thread_state_offset()), _thread_in_native);
+  if (!is_trivial_native) {
+    __ movl(Address(r15_thread, JavaThread::thread_state_offset()), _thread_in_native);
+  }
 
   __ call(RuntimeAddress(native_func));
 
@@ -2504,6 +2513,13 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     }
   }
 #endif
+  Label after_transition;
+
+  if (is_trivial_native) {
+    // Still in _thread_in_Java: nothing to transition back from
+    __ jmp(after_transition);
+  }
+
   // Switch thread to "native transition" state before reading the synchronization state.
   // This additional state is necessary because reading and testing the synchronization
   // state is not atomic w.r.t. GC, as this scenario demonstrates:
@@ -2528,8 +2544,6 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     }
   }
 
-  Label after_transition;
-
   // check for safepoint operation in progress and/or pending suspend requests
   {
     Label Continue;
@@ -53,12 +53,26 @@
   product(bool, UseTransparentHugePages, false,                         \
           "Use MADV_HUGEPAGE for large pages")                          \
                                                                         \
+  product(bool, UseTransparentHugePagesForThreadStacks, false,          \
+          "Use MADV_HUGEPAGE for the large page aligned part of thread "\
+          "stacks. Only used if UseTransparentHugePages is enabled")    \
+                                                                        \
   product(bool, LoadExecStackDllInVMThread, true,                       \
           "Load DLLs with executable-stack attribute in the VM Thread") \
                                                                         \
   product(bool, UseSHM, false,                                          \
           "Use SYSV shared memory for large pages")                     \
                                                                         \
+  product(intx, NativeThreadPoolSize, 0,                                \
+          "Maximum number of native threads of terminated Java threads "\
+          "kept to start new Java threads on. 0 disables the pool")     \
+          range(0, 1024)                                                \
+                                                                        \
+  product(intx, NativeThreadPoolIdleTimeout, 1000,                      \
+          "Milliseconds a pooled native thread waits for a new Java "   \
+          "thread before it terminates")                                \
+          range(1, max_jint)                                            \
+                                                                        \
   product(bool, UseContainerSupport, true,                              \
           "Enable detection and runtime container configuration support") \
                                                                         \
@@ -33,6 +33,9 @@ void OSThread::pd_initialize() {
   assert(this != NULL, "check");
   _thread_id        = 0;
   _pthread_id       = 0;
+  _pthread_stack_size = 0;
+  _cpu_time_base = 0;
+  _user_time_base = 0;
   _siginfo = NULL;
   _ucontext = NULL;
   _expanding_stack = 0;
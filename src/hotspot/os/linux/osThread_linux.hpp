@@ -45,6 +45,16 @@
 
   sigset_t _caller_sigmask; // Caller's signal mask
 
+  // Stack size the native thread was created with. A pooled native
+  // thread is only reused for threads asking for the same stack size.
+  size_t _pthread_stack_size;
+
+  // CPU time (user + sys, and user only) in nanoseconds that earlier
+  // threads used on a pooled native thread. The thread CPU time reported
+  // for this thread does not include it.
+  jlong _cpu_time_base;
+  jlong _user_time_base;
+
  public:
 
   // Methods to save/restore caller's signal mask
@@ -68,6 +78,22 @@
   void set_pthread_id(pthread_t tid) {
     _pthread_id = tid;
   }
+  size_t pthread_stack_size() const {
+    return _pthread_stack_size;
+  }
+  void set_pthread_stack_size(size_t size) {
+    _pthread_stack_size = size;
+  }
+  jlong cpu_time_base() const {
+    return _cpu_time_base;
+  }
+  jlong user_time_base() const {
+    return _user_time_base;
+  }
+  void set_cpu_time_base(jlong cpu_time, jlong user_time) {
+    _cpu_time_base = cpu_time;
+    _user_time_base = user_time;
+  }
 
   // ***************************************************************
   // suspension support.
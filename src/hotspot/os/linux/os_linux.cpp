@@ -28,15 +28,19 @@
 #include "classfile/classLoader.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "code/codeCache.hpp"
 #include "code/icBuffer.hpp"
 #include "code/vtableStubs.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/disassembler.hpp"
+#include "gc/shared/collectedHeap.hpp"
 #include "interpreter/interpreter.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/filemap.hpp"
+#include "memory/metaspace.hpp"
+#include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
 #include "os_linux.inline.hpp"
 #include "os_share_linux.hpp"
@@ -760,14 +764,116 @@ bool os::Linux::manually_expand_stack(JavaThread * t, address addr) {
   return false;
 }
 
+// Define MADV_HUGEPAGE here so we can build HotSpot on old systems.
+#ifndef MADV_HUGEPAGE
+  #define MADV_HUGEPAGE 14
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// native thread pool
+
+// When a Java thread terminates its native thread can wait for a while
+// (NativeThreadPoolIdleTimeout) for a new Java thread asking for the same
+// stack size. That Java thread is then started on the parked native thread
+// which saves the pthread_create(), the mapping of the stack and the
+// matching teardown. The JavaThread is not reused: its resource and handle
+// area chunks, park events and JNI handle blocks already come from free
+// lists.
+class NativeThreadPool : AllStatic {
+ private:
+  struct Entry {
+    Entry*         _next;
+    pthread_t      _tid;
+    size_t         _stack_size;
+    Thread*        _thread;   // Thread to run next, NULL while idle
+    pthread_cond_t _cond;
+  };
+
+  static pthread_mutex_t _lock;
+  static Entry*          _idle;
+  static intx            _idle_count;
+
+ public:
+  static bool is_enabled() { return NativeThreadPoolSize > 0; }
+
+  // Hand thread to an idle native thread created with stack_size.
+  // Returns false if there is none.
+  static bool start(Thread* thread, size_t stack_size, pthread_t* tid);
+
+  // Called by a native thread whose Thread finished running. Returns the
+  // next Thread to run or NULL if the native thread should terminate.
+  static Thread* park(size_t stack_size);
+};
+
+pthread_mutex_t NativeThreadPool::_lock = PTHREAD_MUTEX_INITIALIZER;
+NativeThreadPool::Entry* NativeThreadPool::_idle = NULL;
+intx NativeThreadPool::_idle_count = 0;
+
+bool NativeThreadPool::start(Thread* thread, size_t stack_size, pthread_t* tid) {
+  bool found = false;
+  pthread_mutex_lock(&_lock);
+  for (Entry** p = &_idle; *p != NULL; p = &(*p)->_next) {
+    Entry* e = *p;
+    if (e->_stack_size == stack_size) {
+      *p = e->_next;
+      _idle_count--;
+      e->_thread = thread;
+      *tid = e->_tid;
+      pthread_cond_signal(&e->_cond);
+      found = true;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&_lock);
+  return found;
+}
+
+Thread* NativeThreadPool::park(size_t stack_size) {
+  Entry e;
+  e._next = NULL;
+  e._tid = pthread_self();
+  e._stack_size = stack_size;
+  e._thread = NULL;
+  pthread_cond_init(&e._cond, NULL);
+
+  pthread_mutex_lock(&_lock);
+  if (_idle_count < NativeThreadPoolSize) {
+    e._next = _idle;
+    _idle = &e;
+    _idle_count++;
+
+    jlong deadline = os::javaTimeMillis() + NativeThreadPoolIdleTimeout;
+    struct timespec abstime;
+    abstime.tv_sec = deadline / 1000;
+    abstime.tv_nsec = (deadline % 1000) * 1000000;
+
+    int status = 0;
+    while (e._thread == NULL && status != ETIMEDOUT) {
+      status = pthread_cond_timedwait(&e._cond, &_lock, &abstime);
+    }
+    if (e._thread == NULL) {
+      // Timed out, nobody took us off the idle list
+      for (Entry** p = &_idle; *p != NULL; p = &(*p)->_next) {
+        if (*p == &e) {
+          *p = e._next;
+          _idle_count--;
+          break;
+        }
+      }
+    }
+  }
+  pthread_mutex_unlock(&_lock);
+
+  pthread_cond_destroy(&e._cond);
+  return e._thread;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // create new thread
 
 // Thread start routine for all newly created threads
 static void *thread_native_entry(Thread *thread) {
 
-  thread->record_stack_base_and_size();
-
 #ifndef __GLIBC__
   // Try to randomize the cache line index of hot stack frames.
   // This helps when threads of the same stack traces evict each other's
@@ -783,51 +889,84 @@ static void *thread_native_entry(Thread *thread) {
   *(char *)stackmem = 1;
 #endif
 
-  thread->initialize_thread_current();
+  // A pooled native thread runs one Thread after the other
+  bool reused = false;
+  do {
+    thread->record_stack_base_and_size();
+
+    if (UseTransparentHugePages && UseTransparentHugePagesForThreadStacks) {
+      // Only the large page aligned part of the stack can be backed by
+      // huge pages
+      size_t large_page_size = os::large_page_size();
+      char* low = align_up((char*)thread->stack_end(), large_page_size);
+      char* high = align_down((char*)thread->stack_base(), large_page_size);
+      if (low < high) {
+        ::madvise(low, high - low, MADV_HUGEPAGE);
+      }
+    }
 
-  OSThread* osthread = thread->osthread();
-  Monitor* sync = osthread->startThread_lock();
+    thread->initialize_thread_current();
 
-  osthread->set_thread_id(os::current_thread_id());
+    OSThread* osthread = thread->osthread();
+    Monitor* sync = osthread->startThread_lock();
 
-  log_info(os, thread)("Thread is alive (tid: " UINTX_FORMAT ", pthread id: " UINTX_FORMAT ").",
-    os::current_thread_id(), (uintx) pthread_self());
+    osthread->set_thread_id(os::current_thread_id());
 
-  if (UseNUMA) {
-    int lgrp_id = os::numa_get_group_id();
-    if (lgrp_id != -1) {
-      thread->set_lgrp_id(lgrp_id);
+    if (reused) {
+      // The CPU clock of the native thread keeps running across the threads
+      // it ran. Report CPU time from here on, like for a fresh thread.
+      osthread->set_cpu_time_base(os::current_thread_cpu_time(),
+                                  os::current_thread_cpu_time(false /* user only */));
     }
-  }
-  // initialize signal mask for this thread
-  os::Linux::hotspot_sigmask(thread);
 
-  // initialize floating point control register
-  os::Linux::init_thread_fpu_state();
+    log_info(os, thread)("Thread is alive (tid: " UINTX_FORMAT ", pthread id: " UINTX_FORMAT ").",
+      os::current_thread_id(), (uintx) pthread_self());
 
-  // handshaking with parent thread
-  {
-    MutexLockerEx ml(sync, Mutex::_no_safepoint_check_flag);
+    if (UseNUMA) {
+      int lgrp_id = os::numa_get_group_id();
+      if (lgrp_id != -1) {
+        thread->set_lgrp_id(lgrp_id);
+      }
+    }
+    // initialize signal mask for this thread
+    os::Linux::hotspot_sigmask(thread);
 
-    // notify parent thread
-    osthread->set_state(INITIALIZED);
-    sync->notify_all();
+    // initialize floating point control register
+    os::Linux::init_thread_fpu_state();
 
-    // wait until os::start_thread()
-    while (osthread->get_state() == INITIALIZED) {
-      sync->wait(Mutex::_no_safepoint_check_flag);
+    // handshaking with parent thread
+    {
+      MutexLockerEx ml(sync, Mutex::_no_safepoint_check_flag);
+
+      // notify parent thread
+      osthread->set_state(INITIALIZED);
+      sync->notify_all();
+
+      // wait until os::start_thread()
+      while (osthread->get_state() == INITIALIZED) {
+        sync->wait(Mutex::_no_safepoint_check_flag);
+      }
     }
-  }
 
-  // call one more level start routine
-  thread->call_run();
+    // The OSThread goes away with the thread object
+    bool poolable = NativeThreadPool::is_enabled() && osthread->thread_type() == os::java_thread;
+    size_t stack_size = osthread->pthread_stack_size();
 
-  // Note: at this point the thread object may already have deleted itself.
-  // Prevent dereferencing it from here on out.
-  thread = NULL;
+    // call one more level start routine
+    thread->call_run();
 
-  log_info(os, thread)("Thread finished (tid: " UINTX_FORMAT ", pthread id: " UINTX_FORMAT ").",
-    os::current_thread_id(), (uintx) pthread_self());
+    // Note: at this point the thread object may already have deleted itself.
+    // Prevent dereferencing it from here on out.
+    thread = NULL;
+
+    log_info(os, thread)("Thread finished (tid: " UINTX_FORMAT ", pthread id: " UINTX_FORMAT ").",
+      os::current_thread_id(), (uintx) pthread_self());
+
+    if (poolable) {
+      thread = NativeThreadPool::park(stack_size);
+      reused = true;
+    }
+  } while (thread != NULL);
 
   return 0;
 }
@@ -876,6 +1015,8 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
   // Configure glibc guard page.
   pthread_attr_setguardsize(&attr, os::Linux::default_guard_size(thr_type));
 
+  osthread->set_pthread_stack_size(stack_size);
+
   ThreadState state;
 
   {
@@ -883,12 +1024,19 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
     pthread_t tid;
     int ret = 0;
     int limit = 3;
-    do {
-      ret = pthread_create(&tid, &attr, (void* (*)(void*)) thread_native_entry, thread);
-    } while (ret == EAGAIN && limit-- > 0);
+    bool pooled = thr_type == java_thread && NativeThreadPool::is_enabled() &&
+                  NativeThreadPool::start(thread, stack_size, &tid);
+    if (!pooled) {
+      do {
+        ret = pthread_create(&tid, &attr, (void* (*)(void*)) thread_native_entry, thread);
+      } while (ret == EAGAIN && limit-- > 0);
+    }
 
     char buf[64];
-    if (ret == 0) {
+    if (pooled) {
+      log_info(os, thread)("Thread \"%s\" started on pooled native thread (pthread id: " UINTX_FORMAT ").",
+                           thread->name(), (uintx) tid);
+    } else if (ret == 0) {
       log_info(os, thread)("Thread \"%s\" started (pthread id: " UINTX_FORMAT ", attributes: %s). ",
                            thread->name(), (uintx) tid, os::Posix::describe_pthread_attr(buf, sizeof(buf), &attr));
     } else {
@@ -2169,6 +2317,8 @@ void os::print_os_info(outputStream* st) {
 
   os::Linux::print_process_memory_info(st);
 
+  os::Linux::print_transparent_huge_pages_usage(st);
+
   os::Linux::print_proc_sys_info(st);
 
   os::Linux::print_ld_preload_file(st);
@@ -2437,6 +2587,55 @@ void os::Linux::print_process_memory_info(outputStream* st) {
 #endif
 }
 
+// Print how much of the Java heap, the code cache and metaspace is
+// actually backed by transparent huge pages, summed up from the
+// AnonHugePages of the mappings in /proc/self/smaps.
+void os::Linux::print_transparent_huge_pages_usage(outputStream* st) {
+  if (!UseTransparentHugePages) {
+    return;
+  }
+  enum { java_heap, code_cache, metaspace, other, num_areas };
+  static const char* const area_names[num_areas] = { "Java heap", "code cache", "metaspace", "other" };
+  size_t huge_kb[num_areas] = { 0, 0, 0, 0 };
+
+  FILE* f = ::fopen("/proc/self/smaps", "r");
+  if (f == NULL) {
+    st->print_cr("Could not open /proc/self/smaps to get transparent huge page usage");
+    return;
+  }
+  char buf[256];
+  int area = other;
+  while (::fgets(buf, sizeof(buf), f) != NULL) {
+    unsigned long start, end;
+    size_t kb;
+    if (sscanf(buf, "%lx-%lx", &start, &end) == 2) {
+      // Mapping header line
+      const void* addr = (const void*)start;
+      if (Universe::heap() != NULL && Universe::heap()->is_in_reserved(addr)) {
+        area = java_heap;
+      } else if (CodeCache::contains((void*)addr)) {
+        area = code_cache;
+      } else if (Metaspace::contains(addr)) {
+        area = metaspace;
+      } else {
+        area = other;
+      }
+    } else if (sscanf(buf, "AnonHugePages: " SIZE_FORMAT " kB", &kb) == 1) {
+      huge_kb[area] += kb;
+    }
+    // Skip the rest of lines longer than the buffer (long mapping names)
+    while (strchr(buf, '\n') == NULL && ::fgets(buf, sizeof(buf), f) != NULL) {
+    }
+  }
+  fclose(f);
+
+  st->print("Transparent huge pages:");
+  for (int i = 0; i < num_areas; i++) {
+    st->print("%s %s " SIZE_FORMAT "K", i == 0 ? "" : ",", area_names[i], huge_kb[i]);
+  }
+  st->cr();
+}
+
 void os::Linux::print_ld_preload_file(outputStream* st) {
   _print_ascii_file("/etc/ld.so.preload", st, "\n/etc/ld.so.preload:");
   st->cr();
@@ -3143,11 +3342,6 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size, bool exec,
   #define MAP_HUGETLB 0x40000
 #endif
 
-// Define MADV_HUGEPAGE here so we can build HotSpot on old systems.
-#ifndef MADV_HUGEPAGE
-  #define MADV_HUGEPAGE 14
-#endif
-
 int os::Linux::commit_memory_impl(char* addr, size_t size,
                                   size_t alignment_hint, bool exec) {
   int err = os::Linux::commit_memory_impl(addr, size, exec);
@@ -3863,9 +4057,67 @@ bool os::Linux::transparent_huge_pages_sanity_check(bool warn,
     warning("TransparentHugePages is not supported by the operating system.");
   }
 
+  if (result) {
+    // madvise() succeeds even if the kernel was told to never use
+    // transparent huge pages, so check the mode, too. See
+    // https://www.kernel.org/doc/Documentation/vm/transhuge.txt
+    char enabled[16], defrag[16], khugepaged_defrag[16];
+    bool has_enabled = read_transparent_huge_pages_mode("/sys/kernel/mm/transparent_hugepage/enabled",
+                                                        enabled, sizeof(enabled));
+    bool has_defrag = read_transparent_huge_pages_mode("/sys/kernel/mm/transparent_hugepage/defrag",
+                                                       defrag, sizeof(defrag));
+    bool has_khugepaged = read_transparent_huge_pages_mode("/sys/kernel/mm/transparent_hugepage/khugepaged/defrag",
+                                                           khugepaged_defrag, sizeof(khugepaged_defrag));
+    log_info(pagesize)("Transparent huge pages: enabled=%s defrag=%s khugepaged/defrag=%s",
+                       has_enabled ? enabled : "unknown",
+                       has_defrag ? defrag : "unknown",
+                       has_khugepaged ? khugepaged_defrag : "unknown");
+    if (has_enabled && strcmp(enabled, "never") == 0) {
+      if (warn) {
+        warning("TransparentHugePages is disabled in /sys/kernel/mm/transparent_hugepage/enabled.");
+      }
+      result = false;
+    } else if (has_defrag && strcmp(defrag, "never") == 0 &&
+               has_khugepaged && strcmp(khugepaged_defrag, "0") == 0) {
+      log_info(pagesize)("Transparent huge pages are neither allocated on fault nor collapsed by khugepaged "
+                         "unless huge pages happen to be free");
+    }
+  }
+
   return result;
 }
 
+// Read the active mode of a transparent huge page setting: the word
+// in brackets, e.g. "madvise" for "always [madvise] never", or the
+// plain value for settings that are just a number.
+bool os::Linux::read_transparent_huge_pages_mode(const char* file, char* mode, size_t len) {
+  char buf[128];
+  FILE* f = ::fopen(file, "r");
+  if (f == NULL) {
+    return false;
+  }
+  bool found = ::fgets(buf, sizeof(buf), f) != NULL;
+  fclose(f);
+  if (!found) {
+    return false;
+  }
+  const char* start = strchr(buf, '[');
+  const char* end = NULL;
+  if (start != NULL) {
+    start++;
+    end = strchr(start, ']');
+  } else {
+    start = buf;
+    end = start + strcspn(start, " \n");
+  }
+  if (end == NULL || end == start || (size_t)(end - start) >= len) {
+    return false;
+  }
+  strncpy(mode, start, end - start);
+  mode[end - start] = '\0';
+  return true;
+}
+
 bool os::Linux::hugetlbfs_sanity_check(bool warn, size_t page_size) {
   bool result = false;
   void *p = mmap(NULL, page_size, PROT_READ|PROT_WRITE,
@@ -6060,12 +6312,22 @@ bool os::pd_unmap_memory(char* addr, size_t bytes) {
 
 static jlong slow_thread_cpu_time(Thread *thread, bool user_sys_cpu_time);
 
+// CPU time that earlier threads used on the native thread of thread if it
+// came from the NativeThreadPool, 0 otherwise.
+static jlong cpu_time_base(Thread* thread, bool user_sys_cpu_time) {
+  OSThread* osthread = thread != NULL ? thread->osthread() : NULL;
+  if (osthread == NULL) {
+    return 0;
+  }
+  return user_sys_cpu_time ? osthread->cpu_time_base() : osthread->user_time_base();
+}
+
 static jlong fast_cpu_time(Thread *thread) {
     clockid_t clockid;
     int rc = os::Linux::pthread_getcpuclockid(thread->osthread()->pthread_id(),
                                               &clockid);
     if (rc == 0) {
-      return os::Linux::fast_thread_cpu_time(clockid);
+      return os::Linux::fast_thread_cpu_time(clockid) - cpu_time_base(thread, true);
     } else {
       // It's possible to encounter a terminated native thread that failed
       // to detach itself from the VM - which should result in ESRCH.
@@ -6083,7 +6345,8 @@ static jlong fast_cpu_time(Thread *thread) {
 
 jlong os::current_thread_cpu_time() {
   if (os::Linux::supports_fast_thread_cpu_time()) {
-    return os::Linux::fast_thread_cpu_time(CLOCK_THREAD_CPUTIME_ID);
+    return os::Linux::fast_thread_cpu_time(CLOCK_THREAD_CPUTIME_ID) -
+           cpu_time_base(Thread::current_or_null(), true);
   } else {
     // return user + sys since the cost is the same
     return slow_thread_cpu_time(Thread::current(), true /* user + sys */);
@@ -6101,7 +6364,8 @@ jlong os::thread_cpu_time(Thread* thread) {
 
 jlong os::current_thread_cpu_time(bool user_sys_cpu_time) {
   if (user_sys_cpu_time && os::Linux::supports_fast_thread_cpu_time()) {
-    return os::Linux::fast_thread_cpu_time(CLOCK_THREAD_CPUTIME_ID);
+    return os::Linux::fast_thread_cpu_time(CLOCK_THREAD_CPUTIME_ID) -
+           cpu_time_base(Thread::current_or_null(), true);
   } else {
     return slow_thread_cpu_time(Thread::current(), user_sys_cpu_time);
   }
@@ -6154,9 +6418,11 @@ static jlong slow_thread_cpu_time(Thread *thread, bool user_sys_cpu_time) {
                  &user_time, &sys_time);
   if (count != 13) return -1;
   if (user_sys_cpu_time) {
-    return ((jlong)sys_time + (jlong)user_time) * (1000000000 / clock_tics_per_sec);
+    return ((jlong)sys_time + (jlong)user_time) * (1000000000 / clock_tics_per_sec) -
+           cpu_time_base(thread, true);
   } else {
-    return (jlong)user_time * (1000000000 / clock_tics_per_sec);
+    return (jlong)user_time * (1000000000 / clock_tics_per_sec) -
+           cpu_time_base(thread, false);
   }
 }
 
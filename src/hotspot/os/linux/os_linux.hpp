@@ -97,6 +97,7 @@ class Linux {
 
   static bool setup_large_page_type(size_t page_size);
   static bool transparent_huge_pages_sanity_check(bool warn, size_t pages_size);
+  static bool read_transparent_huge_pages_mode(const char* file, char* mode, size_t len);
   static bool hugetlbfs_sanity_check(bool warn, size_t page_size);
 
   static char* reserve_memory_special_shm(size_t bytes, size_t alignment, char* req_addr, bool exec);
@@ -110,6 +111,7 @@ class Linux {
 
   static void print_process_memory_info(outputStream* st);
   static void print_system_memory_info(outputStream* st);
+  static void print_transparent_huge_pages_usage(outputStream* st);
   static void print_container_info(outputStream* st);
   static void print_steal_info(outputStream* st);
   static void print_distro_info(outputStream* st);
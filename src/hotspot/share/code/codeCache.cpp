@@ -314,7 +314,7 @@ void CodeCache::initialize_heaps() {
 }
 
 size_t CodeCache::page_size(bool aligned, size_t min_pages) {
-  if (os::can_execute_large_page_memory()) {
+  if (UseLargePagesInCodeCache && os::can_execute_large_page_memory()) {
     if (InitialCodeCacheSize < ReservedCodeCacheSize) {
       // Make sure that the page size allows for an incremental commit of the reserved space
       min_pages = MAX2(min_pages, (size_t)8);
@@ -79,6 +79,7 @@ G1Analytics::G1Analytics(const G1Predictions* predictor) :
     _rs_length_diff_seq(new TruncatedSeq(TruncatedSeqLength)),
     _cost_per_card_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _cost_scan_hcc_seq(new TruncatedSeq(TruncatedSeqLength)),
+    _cost_per_buffer_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
     _young_cards_per_entry_ratio_seq(new TruncatedSeq(TruncatedSeqLength)),
     _mixed_cards_per_entry_ratio_seq(new TruncatedSeq(TruncatedSeqLength)),
     _cost_per_entry_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
@@ -166,6 +167,10 @@ void G1Analytics::report_cost_scan_hcc(double cost_scan_hcc) {
   _cost_scan_hcc_seq->add(cost_scan_hcc);
 }
 
+void G1Analytics::report_cost_per_buffer_ms(double cost_per_buffer_ms) {
+  _cost_per_buffer_ms_seq->add(cost_per_buffer_ms);
+}
+
 void G1Analytics::report_cost_per_entry_ms(double cost_per_entry_ms, bool for_young_gc) {
   if (for_young_gc) {
     _cost_per_entry_ms_seq->add(cost_per_entry_ms);
@@ -230,6 +235,13 @@ double G1Analytics::predict_scan_hcc_ms() const {
   return get_new_prediction(_cost_scan_hcc_seq);
 }
 
+double G1Analytics::predict_cost_per_buffer_ms() const {
+  if (_cost_per_buffer_ms_seq->num() == 0) {
+    return 0.0;
+  }
+  return get_new_prediction(_cost_per_buffer_ms_seq);
+}
+
 double G1Analytics::predict_rs_update_time_ms(size_t pending_cards) const {
   return pending_cards * predict_cost_per_card_ms() + predict_scan_hcc_ms();
 }
@@ -48,6 +48,7 @@ class G1Analytics: public CHeapObj<mtGC> {
   TruncatedSeq* _rs_length_diff_seq;
   TruncatedSeq* _cost_per_card_ms_seq;
   TruncatedSeq* _cost_scan_hcc_seq;
+  TruncatedSeq* _cost_per_buffer_ms_seq;
   TruncatedSeq* _young_cards_per_entry_ratio_seq;
   TruncatedSeq* _mixed_cards_per_entry_ratio_seq;
   TruncatedSeq* _cost_per_entry_ms_seq;
@@ -101,6 +102,7 @@ public:
   void report_alloc_rate_ms(double alloc_rate);
   void report_cost_per_card_ms(double cost_per_card_ms);
   void report_cost_scan_hcc(double cost_scan_hcc);
+  void report_cost_per_buffer_ms(double cost_per_buffer_ms);
   void report_cost_per_entry_ms(double cost_per_entry_ms, bool for_young_gc);
   void report_cards_per_entry_ratio(double cards_per_entry_ratio, bool for_young_gc);
   void report_rs_length_diff(double rs_length_diff);
@@ -120,6 +122,9 @@ public:
 
   double predict_scan_hcc_ms() const;
 
+  // Time for a single thread to refine a completed buffer, 0.0 if not known yet.
+  double predict_cost_per_buffer_ms() const;
+
   double predict_rs_update_time_ms(size_t pending_cards) const;
 
   double predict_young_cards_per_entry_ratio() const;
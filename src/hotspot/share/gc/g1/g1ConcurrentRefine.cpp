@@ -26,11 +26,14 @@
 #include "gc/g1/g1BarrierSet.hpp"
 #include "gc/g1/g1ConcurrentRefine.hpp"
 #include "gc/g1/g1ConcurrentRefineThread.hpp"
+#include "gc/shared/gcTrace.hpp"
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/iterator.hpp"
 #include "runtime/java.hpp"
+#include "runtime/os.hpp"
 #include "runtime/thread.hpp"
+#include "runtime/timer.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/pair.hpp"
@@ -198,10 +201,17 @@ inline size_t deactivation_level(const Thresholds& t) { return t.second; }
 
 static Thresholds calc_thresholds(size_t green_zone,
                                   size_t yellow_zone,
-                                  uint worker_i) {
+                                  uint worker_i,
+                                  uint wanted_threads) {
   double yellow_size = yellow_zone - green_zone;
   double step = yellow_size / G1ConcurrentRefine::max_num_threads();
-  if (worker_i == 0) {
+  if (worker_i < wanted_threads) {
+    // Threads the controller predicts to be needed to get down to the green
+    // zone by the next pause are activated with the smallest step, as soon
+    // as the number of buffers exceeds the green zone. The thresholds of the
+    // remaining threads are not affected, keeping them monotonic.
+    step = MIN2(step, ParallelGCThreads / 2.0);
+  } else if (worker_i == 0) {
     // Potentially activate worker 0 more aggressively, to keep
     // available buffers near green_zone value.  When yellow_size is
     // large we don't want to allow a full step to accumulate before
@@ -223,7 +233,15 @@ G1ConcurrentRefine::G1ConcurrentRefine(size_t green_zone,
   _green_zone(green_zone),
   _yellow_zone(yellow_zone),
   _red_zone(red_zone),
-  _min_yellow_zone_size(min_yellow_zone_size)
+  _min_yellow_zone_size(min_yellow_zone_size),
+  _wanted_threads(0),
+  _incoming_buffers_per_ms(0.0),
+  _predicted_ms_per_buffer(0.0),
+  _predicted_time_to_gc_ms(0.0),
+  _last_adjust_counter(os::elapsed_counter()),
+  _last_update_counter(_last_adjust_counter),
+  _completed_buffers_at_last_update(0),
+  _processed_buffers_at_last_update(0)
 {
   assert_zone_constraints_gyr(green_zone, yellow_zone, red_zone);
 }
@@ -376,24 +394,142 @@ void G1ConcurrentRefine::update_zones(double update_rs_time,
             _green_zone, _yellow_zone, _red_zone);
 }
 
+static juint processed_buffers(DirtyCardQueueSet& dcqs) {
+  // The counters may wrap around; only differences are used.
+  return (juint)dcqs.processed_buffers_mut() + (juint)dcqs.processed_buffers_rs_thread();
+}
+
+uint G1ConcurrentRefine::calc_wanted_threads(size_t num_cur_buffers,
+                                             size_t target_buffers,
+                                             double incoming_buffers_per_ms,
+                                             double time_left_ms,
+                                             double ms_per_buffer,
+                                             double min_time_left_ms,
+                                             uint max_threads) {
+  if (ms_per_buffer <= 0.0) {
+    // No prediction available, rely on the zones only.
+    return 0;
+  }
+  double expected_buffers = num_cur_buffers + incoming_buffers_per_ms * time_left_ms;
+  if (expected_buffers <= target_buffers) {
+    return 0;
+  }
+  // Do not let an overdue pause request all threads at once; the next update
+  // will be no earlier than the control interval anyway.
+  time_left_ms = MAX2(time_left_ms, min_time_left_ms);
+  double buffers_per_thread = time_left_ms / ms_per_buffer;
+  double wanted = ceil((expected_buffers - target_buffers) / buffers_per_thread);
+  return (uint)MIN2(wanted, (double)max_threads);
+}
+
+void G1ConcurrentRefine::update_incoming_rate(size_t num_cur_buffers, jlong now) {
+  DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
+
+  juint processed = processed_buffers(dcqs);
+  double elapsed_ms = TimeHelper::counter_to_millis(now - _last_update_counter);
+  if (elapsed_ms > 0.0) {
+    // Buffers that have been completed since the last update, whether they
+    // have been processed in the meantime or not.
+    double incoming = (double)(processed - _processed_buffers_at_last_update) +
+                      (double)num_cur_buffers - (double)_completed_buffers_at_last_update;
+    _incoming_buffers_per_ms = MAX2(incoming, 0.0) / elapsed_ms;
+  }
+  reset_incoming_rate_base(num_cur_buffers, now);
+}
+
+void G1ConcurrentRefine::reset_incoming_rate_base(size_t num_cur_buffers, jlong now) {
+  _last_update_counter = now;
+  _completed_buffers_at_last_update = num_cur_buffers;
+  _processed_buffers_at_last_update = processed_buffers(G1BarrierSet::dirty_card_queue_set());
+}
+
+void G1ConcurrentRefine::update_wanted_threads(size_t num_cur_buffers, jlong now) {
+  double time_left_ms = 0.0;
+  if (_predicted_time_to_gc_ms > 0.0) {
+    time_left_ms = MAX2(_predicted_time_to_gc_ms - TimeHelper::counter_to_millis(now - _last_adjust_counter), 0.0);
+    _wanted_threads = calc_wanted_threads(num_cur_buffers,
+                                          _green_zone,
+                                          _incoming_buffers_per_ms,
+                                          time_left_ms,
+                                          _predicted_ms_per_buffer,
+                                          (double)G1ConcRefinementControlIntervalMillis,
+                                          max_num_threads());
+  } else {
+    // No prediction available, rely on the zones only.
+    _wanted_threads = 0;
+  }
+
+  log_debug( CTRL_TAGS )("Refinement control: "
+                         "buffers: " SIZE_FORMAT ", "
+                         "incoming rate: %.3f/ms, "
+                         "time to next GC: %.3fms, "
+                         "cost per buffer: %.3fms, "
+                         "target: " SIZE_FORMAT ", "
+                         "wanted threads: %u",
+                         num_cur_buffers,
+                         _incoming_buffers_per_ms,
+                         time_left_ms,
+                         _predicted_ms_per_buffer,
+                         _green_zone,
+                         _wanted_threads);
+}
+
+void G1ConcurrentRefine::record_pause_start() {
+  if (G1UseAdaptiveConcRefinement) {
+    // Sample the incoming rate over the mutator phase before the pause
+    // drains the queue.
+    update_incoming_rate(G1BarrierSet::dirty_card_queue_set().completed_buffers_num(), os::elapsed_counter());
+  }
+}
+
+void G1ConcurrentRefine::maybe_update_wanted_threads(size_t num_cur_buffers) {
+  jlong now = os::elapsed_counter();
+  if (TimeHelper::counter_to_millis(now - _last_update_counter) < G1ConcRefinementControlIntervalMillis) {
+    return;
+  }
+  uint old_wanted = _wanted_threads;
+  update_incoming_rate(num_cur_buffers, now);
+  update_wanted_threads(num_cur_buffers, now);
+  if (_wanted_threads != old_wanted) {
+    update_process_completed_threshold();
+  }
+}
+
+void G1ConcurrentRefine::update_process_completed_threshold() {
+  DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
+  if (max_num_threads() == 0) {
+    // Disable dcqs notification when there are no threads to notify.
+    dcqs.set_process_completed_threshold(INT_MAX);
+  } else {
+    // Worker 0 is the primary; wakeup is via dcqs notification.
+    STATIC_ASSERT(max_yellow_zone <= INT_MAX);
+    size_t activate = activation_threshold(0);
+    dcqs.set_process_completed_threshold((int)activate);
+  }
+}
+
 void G1ConcurrentRefine::adjust(double update_rs_time,
                                 size_t update_rs_processed_buffers,
-                                double goal_ms) {
+                                double goal_ms,
+                                double predicted_time_to_gc_ms,
+                                double predicted_ms_per_buffer) {
   DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
 
   if (G1UseAdaptiveConcRefinement) {
     update_zones(update_rs_time, update_rs_processed_buffers, goal_ms);
 
+    jlong now = os::elapsed_counter();
+    _predicted_time_to_gc_ms = predicted_time_to_gc_ms;
+    _predicted_ms_per_buffer = predicted_ms_per_buffer;
+    _last_adjust_counter = now;
+    // The pause has processed the queue: keep the rate sampled at the start
+    // of the pause and count incoming buffers from here.
+    size_t num_cur_buffers = dcqs.completed_buffers_num();
+    reset_incoming_rate_base(num_cur_buffers, now);
+    update_wanted_threads(num_cur_buffers, now);
+
     // Change the barrier params
-    if (max_num_threads() == 0) {
-      // Disable dcqs notification when there are no threads to notify.
-      dcqs.set_process_completed_threshold(INT_MAX);
-    } else {
-      // Worker 0 is the primary; wakeup is via dcqs notification.
-      STATIC_ASSERT(max_yellow_zone <= INT_MAX);
-      size_t activate = activation_threshold(0);
-      dcqs.set_process_completed_threshold((int)activate);
-    }
+    update_process_completed_threshold();
     dcqs.set_max_completed_queue((int)red_zone());
   }
 
@@ -406,13 +542,24 @@ void G1ConcurrentRefine::adjust(double update_rs_time,
   dcqs.notify_if_necessary();
 }
 
+void G1ConcurrentRefine::send_trace_event(G1NewTracer* tracer) {
+  tracer->report_concurrent_refinement_statistics(G1BarrierSet::dirty_card_queue_set().completed_buffers_num(),
+                                                  _green_zone,
+                                                  _yellow_zone,
+                                                  _red_zone,
+                                                  _incoming_buffers_per_ms,
+                                                  _predicted_time_to_gc_ms,
+                                                  _predicted_ms_per_buffer,
+                                                  _wanted_threads);
+}
+
 size_t G1ConcurrentRefine::activation_threshold(uint worker_id) const {
-  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, worker_id);
+  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, worker_id, _wanted_threads);
   return activation_level(thresholds);
 }
 
 size_t G1ConcurrentRefine::deactivation_threshold(uint worker_id) const {
-  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, worker_id);
+  Thresholds thresholds = calc_thresholds(_green_zone, _yellow_zone, worker_id, _wanted_threads);
   return deactivation_level(thresholds);
 }
 
@@ -438,6 +585,10 @@ bool G1ConcurrentRefine::do_refinement_step(uint worker_id) {
     dcqs.set_completed_queue_padding(0);
   }
 
+  if (G1UseAdaptiveConcRefinement && worker_id == 0) {
+    maybe_update_wanted_threads(curr_buffer_num);
+  }
+
   maybe_activate_more_threads(worker_id, curr_buffer_num);
 
   // Process the next buffer, if there are enough left.
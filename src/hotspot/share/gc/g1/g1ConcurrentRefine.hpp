@@ -32,6 +32,7 @@
 class CardTableEntryClosure;
 class G1ConcurrentRefine;
 class G1ConcurrentRefineThread;
+class G1NewTracer;
 class outputStream;
 class ThreadClosure;
 
@@ -92,6 +93,31 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
   size_t _red_zone;
   size_t _min_yellow_zone_size;
 
+  /*
+   * With G1UseAdaptiveConcRefinement the zones are complemented by a
+   * predictive controller. The green zone is the target number of buffers
+   * left for the next pause. From the rate of incoming buffers, the predicted
+   * time until the next pause and the predicted cost of refining a buffer the
+   * controller calculates how many threads need to be running to reach that
+   * target. These "wanted" threads are activated as soon as the number of
+   * buffers exceeds the green zone, instead of waiting for the number of
+   * buffers to climb through the yellow zone. The remaining threads are still
+   * activated gradually in the yellow zone to handle unpredicted bursts.
+   *
+   * The controller is updated at the end of every pause, and periodically by
+   * the primary refinement thread while it is active.
+   */
+  uint _wanted_threads;
+  double _incoming_buffers_per_ms;
+  double _predicted_ms_per_buffer;
+  double _predicted_time_to_gc_ms;
+  // Time stamps of the last pause and the last controller update.
+  jlong _last_adjust_counter;
+  jlong _last_update_counter;
+  // Number of completed and processed buffers at the last controller update.
+  size_t _completed_buffers_at_last_update;
+  juint _processed_buffers_at_last_update;
+
   G1ConcurrentRefine(size_t green_zone,
                      size_t yellow_zone,
                      size_t red_zone,
@@ -102,6 +128,17 @@ class G1ConcurrentRefine : public CHeapObj<mtGC> {
                     size_t update_rs_processed_buffers,
                     double goal_ms);
 
+  // Sample the rate of incoming buffers since the last sample.
+  void update_incoming_rate(size_t num_cur_buffers, jlong now);
+  // Start counting incoming buffers from now, without taking a sample.
+  void reset_incoming_rate_base(size_t num_cur_buffers, jlong now);
+  // Update the number of wanted threads based on the incoming rate and the
+  // time left until the next pause.
+  void update_wanted_threads(size_t num_cur_buffers, jlong now);
+  // Periodic controller update by the primary refinement thread.
+  void maybe_update_wanted_threads(size_t num_cur_buffers);
+  void update_process_completed_threshold();
+
   static uint worker_id_offset();
   void maybe_activate_more_threads(uint worker_id, size_t num_cur_buffers);
 
@@ -115,8 +152,34 @@ public:
 
   void stop();
 
-  // Adjust refinement thresholds based on work done during the pause and the goal time.
-  void adjust(double update_rs_time, size_t update_rs_processed_buffers, double goal_ms);
+  // Adjust refinement thresholds based on work done during the pause and the goal time,
+  // and recalculate the number of wanted threads from the predicted time until the
+  // next pause and the predicted time for a single thread to refine a buffer. A
+  // predicted time of zero means that no prediction is available.
+  void adjust(double update_rs_time,
+              size_t update_rs_processed_buffers,
+              double goal_ms,
+              double predicted_time_to_gc_ms,
+              double predicted_ms_per_buffer);
+
+  // Sample the incoming rate before the pause processes the queue.
+  void record_pause_start();
+
+  // Number of refinement threads needed to get from num_cur_buffers down to
+  // target_buffers by the next pause, time_left_ms from now, with buffers
+  // coming in at incoming_buffers_per_ms and each taking ms_per_buffer to
+  // refine on one thread. time_left_ms is taken to be at least
+  // min_time_left_ms. Returns 0 if ms_per_buffer is not positive.
+  static uint calc_wanted_threads(size_t num_cur_buffers,
+                                  size_t target_buffers,
+                                  double incoming_buffers_per_ms,
+                                  double time_left_ms,
+                                  double ms_per_buffer,
+                                  double min_time_left_ms,
+                                  uint max_threads);
+
+  // Report the current controller state to the given tracer.
+  void send_trace_event(G1NewTracer* tracer);
 
   size_t activation_threshold(uint worker_id) const;
   size_t deactivation_threshold(uint worker_id) const;
@@ -134,6 +197,7 @@ public:
   size_t green_zone() const      { return _green_zone;  }
   size_t yellow_zone() const     { return _yellow_zone; }
   size_t red_zone() const        { return _red_zone;    }
+  uint wanted_threads() const    { return _wanted_threads; }
 };
 
 #endif // SHARE_VM_GC_G1_G1CONCURRENTREFINE_HPP
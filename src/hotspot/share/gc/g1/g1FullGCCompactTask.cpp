@@ -32,6 +32,7 @@
 #include "gc/shared/gcTraceTime.inline.hpp"
 #include "logging/log.hpp"
 #include "oops/oop.inline.hpp"
+#include "utilities/spinYield.hpp"
 #include "utilities/ticks.hpp"
 
 class G1ResetHumongousClosure : public HeapRegionClosure {
@@ -87,14 +88,42 @@ void G1FullGCCompactTask::compact_region(HeapRegion* hr) {
   hr->complete_compaction();
 }
 
+G1FullGCCompactTask::G1FullGCCompactTask(G1FullCollector* collector) :
+    G1FullGCTask("G1 Compact Task", collector),
+    _claimer(collector->workers()) {
+  for (uint i = 0; i < collector->workers(); i++) {
+    collector->compaction_point(i)->prepare_parallel_compaction();
+  }
+}
+
+uint G1FullGCCompactTask::compact_regions(G1FullGCCompactionPoint* cp) {
+  uint num_compacted = 0;
+  uint index;
+  while (cp->claim_next(&index)) {
+    // The regions this region moves objects into have been claimed before,
+    // wait for the workers compacting them to finish.
+    SpinYield spin;
+    while (!cp->is_ready(index)) {
+      spin.wait();
+    }
+    compact_region(cp->regions()->at(index));
+    cp->set_compacted(index);
+    num_compacted++;
+  }
+  return num_compacted;
+}
+
 void G1FullGCCompactTask::work(uint worker_id) {
   Ticks start = Ticks::now();
-  GrowableArray<HeapRegion*>* compaction_queue = collector()->compaction_point(worker_id)->regions();
-  for (GrowableArrayIterator<HeapRegion*> it = compaction_queue->begin();
-       it != compaction_queue->end();
-       ++it) {
-    compact_region(*it);
+  // Compact the own queue first, then steal regions from the other queues.
+  uint num_workers = collector()->workers();
+  uint num_own = compact_regions(collector()->compaction_point(worker_id));
+  uint num_stolen = 0;
+  for (uint i = 1; i < num_workers; i++) {
+    num_stolen += compact_regions(collector()->compaction_point((worker_id + i) % num_workers));
   }
+  log_trace(gc, phases)("Compaction task (%u) compacted %u own and %u stolen regions",
+                        worker_id, num_own, num_stolen);
 
   G1ResetHumongousClosure hc(collector()->mark_bitmap());
   G1CollectedHeap::heap()->heap_region_par_iterate_from_worker_offset(&hc, &_claimer, worker_id);
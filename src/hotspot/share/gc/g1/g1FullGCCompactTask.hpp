@@ -41,11 +41,12 @@ protected:
 
 private:
   void compact_region(HeapRegion* hr);
+  // Compact the regions of the given queue until all have been claimed.
+  // Returns the number of regions compacted by the calling worker.
+  uint compact_regions(G1FullGCCompactionPoint* cp);
 
 public:
-  G1FullGCCompactTask(G1FullCollector* collector) :
-    G1FullGCTask("G1 Compact Task", collector),
-    _claimer(collector->workers()) { }
+  G1FullGCCompactTask(G1FullCollector* collector);
   void work(uint worker_id);
   void serial_compaction();
 
@@ -26,18 +26,30 @@
 #include "gc/g1/g1FullGCCompactionPoint.hpp"
 #include "gc/g1/heapRegion.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/orderAccess.hpp"
 #include "utilities/debug.hpp"
 
 G1FullGCCompactionPoint::G1FullGCCompactionPoint() :
     _current_region(NULL),
     _threshold(NULL),
-    _compaction_top(NULL) {
+    _compaction_top(NULL),
+    _current_index(0),
+    _compacted(NULL),
+    _num_claimed(0) {
   _compaction_regions = new (ResourceObj::C_HEAP, mtGC) GrowableArray<HeapRegion*>(32, true, mtGC);
   _compaction_region_iterator = _compaction_regions->begin();
+  _first_destinations = new (ResourceObj::C_HEAP, mtGC) GrowableArray<uint>(32, true, mtGC);
+  _last_destinations = new (ResourceObj::C_HEAP, mtGC) GrowableArray<uint>(32, true, mtGC);
 }
 
 G1FullGCCompactionPoint::~G1FullGCCompactionPoint() {
   delete _compaction_regions;
+  delete _first_destinations;
+  delete _last_destinations;
+  if (_compacted != NULL) {
+    FREE_C_HEAP_ARRAY(jbyte, _compacted);
+  }
 }
 
 void G1FullGCCompactionPoint::update() {
@@ -71,6 +83,7 @@ HeapRegion* G1FullGCCompactionPoint::current_region() {
 }
 
 HeapRegion* G1FullGCCompactionPoint::next_region() {
+  _current_index++;
   HeapRegion* next = *(++_compaction_region_iterator);
   assert(next != NULL, "Must return valid region");
   return next;
@@ -133,7 +146,16 @@ void G1FullGCCompactionPoint::forward(oop object, size_t size) {
 }
 
 void G1FullGCCompactionPoint::add(HeapRegion* hr) {
+  // Objects of the new region are moved into the current region or later.
+  uint first_destination = is_initialized() ? _current_index : (uint)_compaction_regions->length();
   _compaction_regions->append(hr);
+  _first_destinations->append(first_destination);
+  _last_destinations->append(first_destination);
+}
+
+void G1FullGCCompactionPoint::record_last_destination() {
+  assert(is_initialized(), "Must have been initialized");
+  _last_destinations->at_put(_last_destinations->length() - 1, _current_index);
 }
 
 void G1FullGCCompactionPoint::merge(G1FullGCCompactionPoint* other) {
@@ -141,5 +163,47 @@ void G1FullGCCompactionPoint::merge(G1FullGCCompactionPoint* other) {
 }
 
 HeapRegion* G1FullGCCompactionPoint::remove_last() {
+  _first_destinations->pop();
+  _last_destinations->pop();
   return _compaction_regions->pop();
 }
+
+void G1FullGCCompactionPoint::prepare_parallel_compaction() {
+  assert(_compacted == NULL, "Must only be prepared once");
+  uint length = (uint)_compaction_regions->length();
+  if (length > 0) {
+    _compacted = NEW_C_HEAP_ARRAY(jbyte, length, mtGC);
+    memset((void*)_compacted, 0, length * sizeof(jbyte));
+  }
+  _num_claimed = 0;
+}
+
+bool G1FullGCCompactionPoint::claim_next(uint* index) {
+  uint length = (uint)_compaction_regions->length();
+  if (_num_claimed >= length) {
+    return false;
+  }
+  uint claimed = Atomic::add(1u, &_num_claimed) - 1;
+  if (claimed >= length) {
+    return false;
+  }
+  *index = claimed;
+  return true;
+}
+
+bool G1FullGCCompactionPoint::is_ready(uint index) {
+  // Only the regions the objects are copied into must have been compacted,
+  // their live objects may otherwise still be in the way.
+  uint last = _last_destinations->at(index);
+  assert(last <= index, "Objects must only move towards the start of the queue");
+  for (uint i = _first_destinations->at(index); i <= last && i < index; i++) {
+    if (OrderAccess::load_acquire(&_compacted[i]) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void G1FullGCCompactionPoint::set_compacted(uint index) {
+  OrderAccess::release_store(&_compacted[index], (jbyte)1);
+}
@@ -37,6 +37,18 @@ class G1FullGCCompactionPoint : public CHeapObj<mtGC> {
   HeapWord*   _compaction_top;
   GrowableArray<HeapRegion*>* _compaction_regions;
   GrowableArrayIterator<HeapRegion*> _compaction_region_iterator;
+  uint _current_index;
+
+  // Parallel compaction state. Live objects are only moved towards the start of
+  // the queue, so for every region the queue indices of the first and last
+  // region it moves objects into are recorded. A region may only be compacted
+  // once those destination regions, other than itself, have been compacted.
+  // Regions are claimed in queue order by the owning worker and by workers
+  // stealing work from this queue.
+  GrowableArray<uint>* _first_destinations;
+  GrowableArray<uint>* _last_destinations;
+  volatile jbyte* _compacted;
+  volatile uint _num_claimed;
 
   bool object_will_fit(size_t size);
   void initialize_values(bool init_threshold);
@@ -59,6 +71,19 @@ public:
   HeapRegion* current_region();
 
   GrowableArray<HeapRegion*>* regions();
+
+  // Record the current region as the last destination of the region added last,
+  // called once all its live objects have been forwarded.
+  void record_last_destination();
+
+  // Reset the parallel compaction state before compaction.
+  void prepare_parallel_compaction();
+  // Claim the next region of the queue to compact, returning its index.
+  bool claim_next(uint* index);
+  // Returns whether the region at the given index can be compacted, i.e. all
+  // regions receiving objects from it have been compacted.
+  bool is_ready(uint index);
+  void set_compacted(uint index);
 };
 
 #endif // SHARE_GC_G1_G1FULLGCCOMPACTIONPOINT_HPP
@@ -158,6 +158,7 @@ void G1FullGCPrepareTask::G1CalculatePointersClosure::prepare_for_compaction(Hea
   // Add region to the compaction queue and prepare it.
   _cp->add(hr);
   prepare_for_compaction_work(_cp, hr);
+  _cp->record_last_destination();
 }
 
 void G1FullGCPrepareTask::prepare_serial_compaction() {
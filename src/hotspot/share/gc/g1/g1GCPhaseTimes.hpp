@@ -58,6 +58,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     WaitForStrongCLD,
     WeakCLDRoots,
     SATBFiltering,
+    MergeRS,
     UpdateRS,
     ScanHCC,
     ScanRS,
@@ -78,10 +79,14 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     GCParPhasesSentinel
   };
 
+  enum GCMergeRSWorkItems {
+    MergeRSMergedCards,
+    MergeRSSkippedCards
+  };
+
   enum GCScanRSWorkItems {
     ScanRSScannedCards,
-    ScanRSClaimedCards,
-    ScanRSSkippedCards
+    ScanRSClaimedChunks
   };
 
   enum GCUpdateRSWorkItems {
@@ -102,9 +107,11 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   WorkerDataArray<size_t>* _update_rs_scanned_cards;
   WorkerDataArray<size_t>* _update_rs_skipped_cards;
 
+  WorkerDataArray<size_t>* _merge_rs_merged_cards;
+  WorkerDataArray<size_t>* _merge_rs_skipped_cards;
+
   WorkerDataArray<size_t>* _scan_rs_scanned_cards;
-  WorkerDataArray<size_t>* _scan_rs_claimed_cards;
-  WorkerDataArray<size_t>* _scan_rs_skipped_cards;
+  WorkerDataArray<size_t>* _scan_rs_claimed_chunks;
 
   WorkerDataArray<size_t>* _termination_attempts;
 
@@ -124,6 +131,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
 
   double _cur_derived_pointer_table_update_time_ms;
 
+  double _cur_merge_rs_time_ms;
   double _cur_clear_ct_time_ms;
   double _cur_expand_heap_time_ms;
   double _cur_ref_proc_time_ms;
@@ -205,6 +213,9 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   // return the average time for a phase in milliseconds
   double average_time_ms(GCParPhases phase);
 
+  // return the time for a phase summed over all workers in milliseconds
+  double sum_time_ms(GCParPhases phase);
+
   size_t sum_thread_work_items(GCParPhases phase, uint index = 0);
 
  public:
@@ -221,6 +232,10 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_derived_pointer_table_update_time_ms = ms;
   }
 
+  void record_merge_rs_time_ms(double ms) {
+    _cur_merge_rs_time_ms = ms;
+  }
+
   void record_clear_ct_time(double ms) {
     _cur_clear_ct_time_ms = ms;
   }
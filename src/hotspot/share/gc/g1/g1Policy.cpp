@@ -465,6 +465,7 @@ void G1Policy::record_collection_pause_start(double start_time_sec) {
 
   phase_times()->record_cur_collection_start_sec(start_time_sec);
   _pending_cards = _g1h->pending_card_num();
+  _g1h->concurrent_refine()->record_pause_start();
 
   _collection_set->reset_bytes_used_before();
   _bytes_copied_during_gc = 0;
@@ -498,6 +499,18 @@ void G1Policy::record_concurrent_mark_cleanup_start() {
   _mark_cleanup_start_sec = os::elapsedTime();
 }
 
+double G1Policy::predict_time_to_next_gc_ms() const {
+  if (_analytics->num_alloc_rate_ms() <= 3) {
+    return 0.0;
+  }
+  double alloc_rate_ms = _analytics->predict_alloc_rate_ms();
+  uint eden_regions = _young_list_target_length - MIN2(_young_list_target_length, _g1h->survivor_regions_count());
+  if (alloc_rate_ms <= 0.0 || eden_regions == 0) {
+    return 0.0;
+  }
+  return eden_regions / alloc_rate_ms;
+}
+
 double G1Policy::average_time_ms(G1GCPhaseTimes::GCParPhases phase) const {
   return phase_times()->average_time_ms(phase);
 }
@@ -633,9 +646,18 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
     }
     _analytics->report_cost_scan_hcc(scan_hcc_time_ms);
 
+    size_t update_rs_buffers = phase_times()->sum_thread_work_items(G1GCPhaseTimes::UpdateRS, G1GCPhaseTimes::UpdateRSProcessedBuffers);
+    if (update_rs_buffers > 0) {
+      // Refinement threads work alone on a buffer: use the time summed over
+      // all workers, not the parallel time of the phase.
+      _analytics->report_cost_per_buffer_ms(phase_times()->sum_time_ms(G1GCPhaseTimes::UpdateRS) / update_rs_buffers);
+    }
+
     double cost_per_entry_ms = 0.0;
     if (cards_scanned > 10) {
-      cost_per_entry_ms = average_time_ms(G1GCPhaseTimes::ScanRS) / (double) cards_scanned;
+      // Merging the remembered sets into the card table is part of the cost of scanning them.
+      double scan_rs_time_ms = average_time_ms(G1GCPhaseTimes::MergeRS) + average_time_ms(G1GCPhaseTimes::ScanRS);
+      cost_per_entry_ms = scan_rs_time_ms / (double) cards_scanned;
       _analytics->report_cost_per_entry_ms(cost_per_entry_ms, this_pause_was_young_only);
     }
 
@@ -729,9 +751,13 @@ void G1Policy::record_collection_pause_end(double pause_time_ms, size_t cards_sc
   } else {
     update_rs_time_goal_ms -= scan_hcc_time_ms;
   }
-  _g1h->concurrent_refine()->adjust(average_time_ms(G1GCPhaseTimes::UpdateRS),
-                                    phase_times()->sum_thread_work_items(G1GCPhaseTimes::UpdateRS),
-                                    update_rs_time_goal_ms);
+  G1ConcurrentRefine* cr = _g1h->concurrent_refine();
+  cr->adjust(average_time_ms(G1GCPhaseTimes::UpdateRS),
+             phase_times()->sum_thread_work_items(G1GCPhaseTimes::UpdateRS),
+             update_rs_time_goal_ms,
+             predict_time_to_next_gc_ms(),
+             _analytics->predict_cost_per_buffer_ms());
+  cr->send_trace_event(_g1h->gc_tracer_stw());
 
   cset_chooser()->verify();
 }
@@ -171,6 +171,10 @@ private:
   double average_time_ms(G1GCPhaseTimes::GCParPhases phase) const;
   double other_time_ms(double pause_time_ms) const;
 
+  // Predicted mutator time until the young gen target length is allocated,
+  // or zero if there is not enough allocation rate information yet.
+  double predict_time_to_next_gc_ms() const;
+
   double young_other_time_ms() const;
   double non_young_other_time_ms() const;
   double constant_other_time_ms(double pause_time_ms) const;
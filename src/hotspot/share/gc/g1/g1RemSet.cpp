@@ -56,6 +56,7 @@ class G1RemSetScanState : public CHeapObj<mtGC> {
 private:
   class G1ClearCardTableTask : public AbstractGangTask {
     G1CollectedHeap* _g1h;
+    G1RemSetScanState* _scan_state;
     uint* _dirty_region_list;
     size_t _num_dirty_regions;
     size_t _chunk_length;
@@ -63,11 +64,13 @@ private:
     size_t volatile _cur_dirty_regions;
   public:
     G1ClearCardTableTask(G1CollectedHeap* g1h,
+                         G1RemSetScanState* scan_state,
                          uint* dirty_region_list,
                          size_t num_dirty_regions,
                          size_t chunk_length) :
       AbstractGangTask("G1 Clear Card Table Task"),
       _g1h(g1h),
+      _scan_state(scan_state),
       _dirty_region_list(dirty_region_list),
       _num_dirty_regions(num_dirty_regions),
       _chunk_length(chunk_length),
@@ -84,10 +87,12 @@ private:
         size_t max = MIN2(next + _chunk_length, _num_dirty_regions);
 
         for (size_t i = next; i < max; i++) {
-          HeapRegion* r = _g1h->region_at(_dirty_region_list[i]);
+          uint const region_idx = _dirty_region_list[i];
+          HeapRegion* r = _g1h->region_at(region_idx);
           if (!r->is_survivor()) {
             r->clear_cardtable();
           }
+          _scan_state->clear_dirty_region(region_idx);
         }
       }
     }
@@ -119,9 +124,25 @@ private:
   static const IsDirtyRegionState Dirty = 1;
   // Holds a flag for every region whether it is in the _dirty_region_buffer already
   // to avoid duplicates. Uses jbyte since there are no atomic instructions for bools.
+  // Only set for regions in the _dirty_region_buffer, which are cleared again
+  // together with their card table.
   IsDirtyRegionState* _in_dirty_region_buffer;
   size_t _cur_dirty_region;
 
+  // Number of entries in _dirty_region_buffer after merging the remembered sets
+  // of the collection set into the card table. Only these regions contain cards
+  // that need to be scanned; regions added later only need their card table cleared.
+  size_t _num_merged_regions;
+  // Each merged region is split into chunks of G1RSetScanBlockSize cards.
+  size_t _chunks_per_region;
+  // For every chunk of every region, whether the merge claimed a card in it.
+  // Only these chunks are scanned. Only set for regions in the
+  // _dirty_region_buffer, which are cleared again together with their card table.
+  bool* _region_scan_chunks;
+  // Workers claim this many consecutive chunks of the merged regions at once.
+  size_t _scan_chunks_per_claim;
+  size_t volatile _cur_scan_chunk;
+
   // Creates a snapshot of the current _top values at the start of collection to
   // filter out card marks that we do not want to scan.
   class G1ResetScanTopClosure : public HeapRegionClosure {
@@ -155,6 +176,11 @@ public:
     _dirty_region_buffer(NULL),
     _in_dirty_region_buffer(NULL),
     _cur_dirty_region(0),
+    _num_merged_regions(0),
+    _chunks_per_region(0),
+    _region_scan_chunks(NULL),
+    _scan_chunks_per_claim(1),
+    _cur_scan_chunk(0),
     _scan_top(NULL) {
   }
 
@@ -174,6 +200,9 @@ public:
     if (_scan_top != NULL) {
       FREE_C_HEAP_ARRAY(HeapWord*, _scan_top);
     }
+    if (_region_scan_chunks != NULL) {
+      FREE_C_HEAP_ARRAY(bool, _region_scan_chunks);
+    }
   }
 
   void initialize(uint max_regions) {
@@ -185,7 +214,29 @@ public:
     _dirty_region_buffer = NEW_C_HEAP_ARRAY(uint, max_regions, mtGC);
     _in_dirty_region_buffer = NEW_C_HEAP_ARRAY(IsDirtyRegionState, max_regions, mtGC);
     _scan_top = NEW_C_HEAP_ARRAY(HeapWord*, max_regions, mtGC);
+    _chunks_per_region = align_up(HeapRegion::CardsPerRegion, G1RSetScanBlockSize) / G1RSetScanBlockSize;
+    _region_scan_chunks = NEW_C_HEAP_ARRAY(bool, max_regions * _chunks_per_region, mtGC);
+    memset(_in_dirty_region_buffer, Clean, max_regions * sizeof(IsDirtyRegionState));
+    memset(_region_scan_chunks, false, max_regions * _chunks_per_region * sizeof(bool));
+  }
+
+  // Clear the per-region scan state of a region of the _dirty_region_buffer.
+  void clear_dirty_region(uint region) {
+    _in_dirty_region_buffer[region] = Clean;
+    memset(_region_scan_chunks + (size_t)region * _chunks_per_region, false, _chunks_per_region * sizeof(bool));
+  }
+
+#ifdef ASSERT
+  void verify_dirty_regions_clear() const {
+    for (uint i = 0; i < _max_regions; i++) {
+      assert(_in_dirty_region_buffer[i] == Clean, "Region %u still in dirty region buffer", i);
+    }
+    for (size_t i = 0; i < _max_regions * _chunks_per_region; i++) {
+      assert(!_region_scan_chunks[i], "Chunk " SIZE_FORMAT " of region " SIZE_FORMAT " still dirty",
+             i % _chunks_per_region, i / _chunks_per_region);
+    }
   }
+#endif
 
   void reset() {
     for (uint i = 0; i < _max_regions; i++) {
@@ -196,8 +247,13 @@ public:
     G1CollectedHeap::heap()->heap_region_iterate(&cl);
 
     memset((void*)_iter_claims, 0, _max_regions * sizeof(size_t));
-    memset(_in_dirty_region_buffer, Clean, _max_regions * sizeof(IsDirtyRegionState));
+    // The dirty region flags and scan chunks were cleared along with the
+    // card table of the dirty regions at the end of the previous pause.
+    DEBUG_ONLY(verify_dirty_regions_clear();)
     _cur_dirty_region = 0;
+    _num_merged_regions = 0;
+    _scan_chunks_per_claim = 1;
+    _cur_scan_chunk = 0;
   }
 
   // Attempt to claim the remembered set of the region for iteration. Returns true
@@ -255,7 +311,58 @@ public:
     return _scan_top[region_idx];
   }
 
-  // Clear the card table of "dirty" regions.
+  // Record that the merge claimed the given card for scanning.
+  void set_chunk_dirty(size_t card_index) {
+    size_t const region_idx = card_index / HeapRegion::CardsPerRegion;
+    size_t const chunk = region_idx * _chunks_per_region +
+                         (card_index % HeapRegion::CardsPerRegion) / G1RSetScanBlockSize;
+    if (!_region_scan_chunks[chunk]) {
+      _region_scan_chunks[chunk] = true;
+    }
+  }
+
+  // Called after all remembered sets of the collection set have been merged
+  // into the card table to fix the set of regions to scan.
+  void set_merge_complete(uint num_workers) {
+    _num_merged_regions = _cur_dirty_region;
+    // Claim in units of up to a region, but leave a few claims per worker
+    // for load balancing. Chunks without merged cards cost a byte load only.
+    size_t const num_chunks = _num_merged_regions * _chunks_per_region;
+    _scan_chunks_per_claim = MAX2(MIN2(num_chunks / ((size_t)num_workers * 8), _chunks_per_region), (size_t)1);
+  }
+
+  size_t num_merged_regions() const { return _num_merged_regions; }
+
+  // Claim the next range [first, end) of chunks of the merged regions. Returns
+  // false if there are no chunks left.
+  inline bool claim_scan_chunks(size_t& first, size_t& end) {
+    size_t const num_chunks = _num_merged_regions * _chunks_per_region;
+    if (_cur_scan_chunk >= num_chunks) {
+      return false;
+    }
+    first = Atomic::add(_scan_chunks_per_claim, &_cur_scan_chunk) - _scan_chunks_per_claim;
+    if (first >= num_chunks) {
+      return false;
+    }
+    end = MIN2(first + _scan_chunks_per_claim, num_chunks);
+    return true;
+  }
+
+  // Returns whether the given chunk of the merged regions contains merged
+  // cards, and if so its region and card range [start_card, end_card).
+  inline bool chunk_to_scan(size_t chunk, uint& region_idx, size_t& start_card, size_t& end_card) const {
+    region_idx = _dirty_region_buffer[chunk / _chunks_per_region];
+    size_t const chunk_in_region = chunk % _chunks_per_region;
+    if (!_region_scan_chunks[(size_t)region_idx * _chunks_per_region + chunk_in_region]) {
+      return false;
+    }
+    size_t const region_start_card = (size_t)region_idx * HeapRegion::CardsPerRegion;
+    start_card = region_start_card + chunk_in_region * G1RSetScanBlockSize;
+    end_card = MIN2(start_card + G1RSetScanBlockSize, region_start_card + HeapRegion::CardsPerRegion);
+    return true;
+  }
+
+  // Clear the card table and scan state of "dirty" regions.
   void clear_card_table(WorkGang* workers) {
     if (_cur_dirty_region == 0) {
       return;
@@ -266,7 +373,7 @@ public:
     size_t const chunk_length = G1ClearCardTableTask::chunk_size() / HeapRegion::CardsPerRegion;
 
     // Iterate over the dirty cards region list.
-    G1ClearCardTableTask cl(G1CollectedHeap::heap(), _dirty_region_buffer, _cur_dirty_region, chunk_length);
+    G1ClearCardTableTask cl(G1CollectedHeap::heap(), this, _dirty_region_buffer, _cur_dirty_region, chunk_length);
 
     log_debug(gc, ergo)("Running %s using %u workers for " SIZE_FORMAT " "
                         "units of work for " SIZE_FORMAT " regions.",
@@ -306,6 +413,111 @@ void G1RemSet::initialize(size_t capacity, uint max_regions) {
   _scan_state->initialize(max_regions);
 }
 
+// Marks the cards of the remembered sets of the collection set regions as claimed
+// in the card table. This removes duplicates between remembered sets of different
+// regions and allows scanning the resulting cards in evenly sized chunks.
+class G1MergeRemSetClosure : public HeapRegionClosure {
+  G1CollectedHeap* _g1h;
+  G1CardTable* _ct;
+  G1RemSetScanState* _scan_state;
+
+  size_t _cards_merged;
+  size_t _cards_skipped;
+public:
+  G1MergeRemSetClosure(G1CollectedHeap* g1h, G1RemSetScanState* scan_state) :
+    _g1h(g1h),
+    _ct(g1h->card_table()),
+    _scan_state(scan_state),
+    _cards_merged(0),
+    _cards_skipped(0) {
+  }
+
+  bool do_heap_region(HeapRegion* r) {
+    assert(r->in_collection_set(),
+           "Should only be called on elements of the collection set but region %u is not.",
+           r->hrm_index());
+    uint const region_idx = r->hrm_index();
+
+    if (_scan_state->claim_iter(region_idx)) {
+      // If we ever free the collection set concurrently, we should also
+      // clear the card table concurrently therefore we won't need to
+      // add regions of the collection set to the dirty cards region.
+      _scan_state->add_dirty_region(region_idx);
+    }
+
+    // We claim cards in blocks so as to reduce the contention.
+    size_t const block_size = G1RSetScanBlockSize;
+
+    HeapRegionRemSetIterator iter(r->rem_set());
+    size_t card_index;
+
+    size_t claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
+    for (size_t current_card = 0; iter.has_next(card_index); current_card++) {
+      if (current_card >= claimed_card_block + block_size) {
+        claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
+      }
+      if (current_card < claimed_card_block) {
+        continue;
+      }
+
+      // Already merged from another remembered set, or dirty, in which case
+      // G1 will scan it during Update RS.
+      if (_ct->is_card_claimed(card_index) || _ct->is_card_dirty(card_index)) {
+        _cards_skipped++;
+        continue;
+      }
+
+      HeapWord* const card_start = _g1h->bot()->address_for_index(card_index);
+      uint const region_idx_for_card = _g1h->addr_to_region(card_start);
+
+      assert(_g1h->region_at(region_idx_for_card)->is_in_reserved(card_start),
+             "Card start " PTR_FORMAT " to scan outside of region %u", p2i(card_start), _g1h->region_at(region_idx_for_card)->hrm_index());
+      // Do not claim cards above the scan top: the remembered set may contain
+      // random cards into current survivor, and we would then have an incorrectly
+      // claimed card in survivor space. Card table clear does not reset the card
+      // table of survivor space regions.
+      if (card_start >= _scan_state->scan_top(region_idx_for_card)) {
+        _cards_skipped++;
+        continue;
+      }
+
+      // Races between threads merging the same card are benign, it will only
+      // be scanned once.
+      _ct->set_card_claimed(card_index);
+      _scan_state->set_chunk_dirty(card_index);
+      _scan_state->add_dirty_region(region_idx_for_card);
+      _cards_merged++;
+    }
+    return false;
+  }
+
+  size_t cards_merged() const { return _cards_merged; }
+  size_t cards_skipped() const { return _cards_skipped; }
+};
+
+class G1MergeRemSetTask : public AbstractGangTask {
+  G1CollectedHeap* _g1h;
+  G1RemSetScanState* _scan_state;
+public:
+  G1MergeRemSetTask(G1CollectedHeap* g1h, G1RemSetScanState* scan_state) :
+    AbstractGangTask("G1 Merge Remembered Sets"),
+    _g1h(g1h),
+    _scan_state(scan_state) {
+  }
+
+  void work(uint worker_id) {
+    G1GCPhaseTimes* p = _g1h->g1_policy()->phase_times();
+    Ticks start = Ticks::now();
+
+    G1MergeRemSetClosure cl(_g1h, _scan_state);
+    _g1h->collection_set_iterate_from(&cl, worker_id);
+
+    p->record_time_secs(G1GCPhaseTimes::MergeRS, worker_id, (Ticks::now() - start).seconds());
+    p->record_thread_work_item(G1GCPhaseTimes::MergeRS, worker_id, cl.cards_merged(), G1GCPhaseTimes::MergeRSMergedCards);
+    p->record_thread_work_item(G1GCPhaseTimes::MergeRS, worker_id, cl.cards_skipped(), G1GCPhaseTimes::MergeRSSkippedCards);
+  }
+};
+
 G1ScanRSForRegionClosure::G1ScanRSForRegionClosure(G1RemSetScanState* scan_state,
                                                    G1ScanObjsDuringScanRSClosure* scan_obj_on_card,
                                                    G1ParScanThreadState* pss,
@@ -316,20 +528,14 @@ G1ScanRSForRegionClosure::G1ScanRSForRegionClosure(G1RemSetScanState* scan_state
   _scan_objs_on_card_cl(scan_obj_on_card),
   _scan_state(scan_state),
   _worker_i(worker_i),
-  _cards_claimed(0),
   _cards_scanned(0),
-  _cards_skipped(0),
+  _chunks_claimed(0),
   _rem_set_root_scan_time(),
   _rem_set_trim_partially_time(),
   _strong_code_root_scan_time(),
   _strong_code_trim_partially_time() {
 }
 
-void G1ScanRSForRegionClosure::claim_card(size_t card_index, const uint region_idx_for_card){
-  _ct->set_card_claimed(card_index);
-  _scan_state->add_dirty_region(region_idx_for_card);
-}
-
 void G1ScanRSForRegionClosure::scan_card(MemRegion mr, uint region_idx_for_card) {
   HeapRegion* const card_region = _g1h->region_at(region_idx_for_card);
   _scan_objs_on_card_cl->set_region(card_region);
@@ -338,59 +544,42 @@ void G1ScanRSForRegionClosure::scan_card(MemRegion mr, uint region_idx_for_card)
   _cards_scanned++;
 }
 
-void G1ScanRSForRegionClosure::scan_rem_set_roots(HeapRegion* r) {
-  uint const region_idx = r->hrm_index();
-
-  if (_scan_state->claim_iter(region_idx)) {
-    // If we ever free the collection set concurrently, we should also
-    // clear the card table concurrently therefore we won't need to
-    // add regions of the collection set to the dirty cards region.
-    _scan_state->add_dirty_region(region_idx);
-  }
-
-  // We claim cards in blocks so as to reduce the contention.
-  size_t const block_size = G1RSetScanBlockSize;
-
-  HeapRegionRemSetIterator iter(r->rem_set());
-  size_t card_index;
-
-  size_t claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
-  for (size_t current_card = 0; iter.has_next(card_index); current_card++) {
-    if (current_card >= claimed_card_block + block_size) {
-      claimed_card_block = _scan_state->iter_claimed_next(region_idx, block_size);
-    }
-    if (current_card < claimed_card_block) {
-      _cards_skipped++;
-      continue;
-    }
-    _cards_claimed++;
+void G1ScanRSForRegionClosure::scan_chunk(uint region_idx, size_t start_card, size_t end_card) {
+  HeapWord* const top = _scan_state->scan_top(region_idx);
+  assert(_ct->index_for(_g1h->region_at(region_idx)->bottom()) <= start_card,
+         "Chunk starting at card " SIZE_FORMAT " outside of region %u", start_card, region_idx);
 
-    // If the card is dirty, then G1 will scan it during Update RS.
-    if (_ct->is_card_claimed(card_index) || _ct->is_card_dirty(card_index)) {
+  for (size_t card_index = start_card; card_index < end_card; card_index++) {
+    if (!_ct->is_card_claimed(card_index)) {
       continue;
     }
-
     HeapWord* const card_start = _g1h->bot()->address_for_index(card_index);
-    uint const region_idx_for_card = _g1h->addr_to_region(card_start);
-
-    assert(_g1h->region_at(region_idx_for_card)->is_in_reserved(card_start),
-           "Card start " PTR_FORMAT " to scan outside of region %u", p2i(card_start), _g1h->region_at(region_idx_for_card)->hrm_index());
-    HeapWord* const top = _scan_state->scan_top(region_idx_for_card);
+    // Cards above the scan top have never been merged.
     if (card_start >= top) {
-      continue;
+      break;
     }
-
-    // We claim lazily (so races are possible but they're benign), which reduces the
-    // number of duplicate scans (the rsets of the regions in the cset can intersect).
-    // Claim the card after checking bounds above: the remembered set may contain
-    // random cards into current survivor, and we would then have an incorrectly
-    // claimed card in survivor space. Card table clear does not reset the card table
-    // of survivor space regions.
-    claim_card(card_index, region_idx_for_card);
-
     MemRegion const mr(card_start, MIN2(card_start + BOTConstants::N_words, top));
+    scan_card(mr, region_idx);
+  }
+}
 
-    scan_card(mr, region_idx_for_card);
+void G1ScanRSForRegionClosure::scan_merged_cards() {
+  G1EvacPhaseWithTrimTimeTracker timer(_pss, _rem_set_root_scan_time, _rem_set_trim_partially_time);
+
+  size_t chunk;
+  size_t end;
+  while (_scan_state->claim_scan_chunks(chunk, end)) {
+    for (; chunk < end; chunk++) {
+      uint region_idx;
+      size_t start_card;
+      size_t end_card;
+      // Skips the chunks of collection set regions too, which are only in
+      // the list to get their card table cleared.
+      if (_scan_state->chunk_to_scan(chunk, region_idx, start_card, end_card)) {
+        _chunks_claimed++;
+        scan_chunk(region_idx, start_card, end_card);
+      }
+    }
   }
 }
 
@@ -404,27 +593,33 @@ bool G1ScanRSForRegionClosure::do_heap_region(HeapRegion* r) {
          r->hrm_index());
   uint const region_idx = r->hrm_index();
 
-  // Do an early out if we know we are complete.
-  if (_scan_state->iter_is_complete(region_idx)) {
-    return false;
-  }
-
-  {
-    G1EvacPhaseWithTrimTimeTracker timer(_pss, _rem_set_root_scan_time, _rem_set_trim_partially_time);
-    scan_rem_set_roots(r);
-  }
-
+  // All remembered sets have been claimed during the merge; the thread completing
+  // the iteration scans the strong code root list attached to the region.
   if (_scan_state->set_iter_complete(region_idx)) {
     G1EvacPhaseWithTrimTimeTracker timer(_pss, _strong_code_root_scan_time, _strong_code_trim_partially_time);
-    // Scan the strong code root list attached to the current region
     scan_strong_code_roots(r);
   }
   return false;
 }
 
+void G1RemSet::merge_rem_sets() {
+  G1GCPhaseTimes* p = _g1p->phase_times();
+  Ticks start = Ticks::now();
+
+  WorkGang* workers = _g1h->workers();
+  G1MergeRemSetTask cl(_g1h, _scan_state);
+  log_debug(gc, ergo)("Running %s using %u workers for %u regions in the collection set.",
+                      cl.name(), workers->active_workers(), _g1h->collection_set()->region_length());
+  workers->run_task(&cl);
+
+  _scan_state->set_merge_complete(workers->active_workers());
+  p->record_merge_rs_time_ms((Ticks::now() - start).seconds() * 1000.0);
+}
+
 void G1RemSet::scan_rem_set(G1ParScanThreadState* pss, uint worker_i) {
   G1ScanObjsDuringScanRSClosure scan_cl(_g1h, pss);
   G1ScanRSForRegionClosure cl(_scan_state, &scan_cl, pss, worker_i);
+  cl.scan_merged_cards();
   _g1h->collection_set_iterate_from(&cl, worker_i);
 
   G1GCPhaseTimes* p = _g1p->phase_times();
@@ -433,8 +628,7 @@ void G1RemSet::scan_rem_set(G1ParScanThreadState* pss, uint worker_i) {
   p->add_time_secs(G1GCPhaseTimes::ObjCopy, worker_i, cl.rem_set_trim_partially_time().seconds());
 
   p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.cards_scanned(), G1GCPhaseTimes::ScanRSScannedCards);
-  p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.cards_claimed(), G1GCPhaseTimes::ScanRSClaimedCards);
-  p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.cards_skipped(), G1GCPhaseTimes::ScanRSSkippedCards);
+  p->record_thread_work_item(G1GCPhaseTimes::ScanRS, worker_i, cl.chunks_claimed(), G1GCPhaseTimes::ScanRSClaimedChunks);
 
   p->record_time_secs(G1GCPhaseTimes::CodeRoots, worker_i, cl.strong_code_root_scan_time().seconds());
   p->add_time_secs(G1GCPhaseTimes::ObjCopy, worker_i, cl.strong_code_root_trim_partially_time().seconds());
@@ -513,6 +707,7 @@ void G1RemSet::prepare_for_oops_into_collection_set_do() {
   dcqs.concatenate_logs();
 
   _scan_state->reset();
+  merge_rem_sets();
 }
 
 void G1RemSet::cleanup_after_oops_into_collection_set_do() {
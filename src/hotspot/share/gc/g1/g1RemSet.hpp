@@ -60,8 +60,12 @@ private:
 
   G1RemSetSummary _prev_period_summary;
 
-  // Scan all remembered sets of the collection set for references into the collection
-  // set.
+  // Merge the remembered sets of all regions in the collection set into the card
+  // table in parallel, marking the cards to scan as claimed.
+  void merge_rem_sets();
+
+  // Scan all cards merged from the remembered sets of the collection set for
+  // references into the collection set.
   void scan_rem_set(G1ParScanThreadState* pss, uint worker_i);
 
   // Flush remaining refinement buffers for cross-region references to either evacuate references
@@ -146,8 +150,7 @@ class G1ScanRSForRegionClosure : public HeapRegionClosure {
   uint   _worker_i;
 
   size_t _cards_scanned;
-  size_t _cards_claimed;
-  size_t _cards_skipped;
+  size_t _chunks_claimed;
 
   Tickspan _rem_set_root_scan_time;
   Tickspan _rem_set_trim_partially_time;
@@ -155,10 +158,9 @@ class G1ScanRSForRegionClosure : public HeapRegionClosure {
   Tickspan _strong_code_root_scan_time;
   Tickspan _strong_code_trim_partially_time;
 
-  void claim_card(size_t card_index, const uint region_idx_for_card);
   void scan_card(MemRegion mr, uint region_idx_for_card);
+  void scan_chunk(uint region_idx, size_t start_card, size_t end_card);
 
-  void scan_rem_set_roots(HeapRegion* r);
   void scan_strong_code_roots(HeapRegion* r);
 public:
   G1ScanRSForRegionClosure(G1RemSetScanState* scan_state,
@@ -166,6 +168,13 @@ public:
                            G1ParScanThreadState* pss,
                            uint worker_i);
 
+  // Scan the claimed cards in the card table, claiming ranges of chunks of the
+  // merged regions until there are none left. Only chunks that the merge
+  // claimed cards in are scanned.
+  void scan_merged_cards();
+
+  // Scan the strong code roots of the given collection set region if not
+  // already done by another thread.
   bool do_heap_region(HeapRegion* r);
 
   Tickspan rem_set_root_scan_time() const { return _rem_set_root_scan_time; }
@@ -175,8 +184,7 @@ public:
   Tickspan strong_code_root_trim_partially_time() const { return _strong_code_trim_partially_time; }
 
   size_t cards_scanned() const { return _cards_scanned; }
-  size_t cards_claimed() const { return _cards_claimed; }
-  size_t cards_skipped() const { return _cards_skipped; }
+  size_t chunks_claimed() const { return _chunks_claimed; }
 };
 
 #endif // SHARE_VM_GC_G1_G1REMSET_HPP
@@ -220,6 +220,38 @@ public:
   }
 };
 
+// Accumulates memory and card occupancy of one kind of remembered set
+// container (sparse, fine or coarse) over all regions.
+class ContainerTypeCounter {
+private:
+  const char* _name;
+
+  size_t _mem_size;
+  size_t _cards_occupied;
+  size_t _entries;
+
+public:
+  ContainerTypeCounter(const char* name) : _name(name), _mem_size(0),
+    _cards_occupied(0), _entries(0) { }
+
+  void add(size_t mem_size, size_t cards_occupied, size_t entries) {
+    _mem_size += mem_size;
+    _cards_occupied += cards_occupied;
+    _entries += entries;
+  }
+
+  size_t mem_size() const { return _mem_size; }
+
+  void print_on(outputStream* out, size_t total_mem_size, size_t total_cards_occupied) {
+    out->print_cr("    " SIZE_FORMAT_W(8) "%s (%5.1f%%), " SIZE_FORMAT " entries, "
+                  SIZE_FORMAT " (%5.1f%%) cards in %s containers",
+                  byte_size_in_proper_unit(_mem_size),
+                  proper_unit_for_byte_size(_mem_size),
+                  percent_of(_mem_size, total_mem_size), _entries,
+                  _cards_occupied, percent_of(_cards_occupied, total_cards_occupied), _name);
+  }
+};
+
 
 class HRRSStatsIter: public HeapRegionClosure {
 private:
@@ -229,6 +261,10 @@ private:
   RegionTypeCounter _old;
   RegionTypeCounter _all;
 
+  ContainerTypeCounter _sparse;
+  ContainerTypeCounter _fine;
+  ContainerTypeCounter _coarse;
+
   size_t _max_rs_mem_sz;
   HeapRegion* _max_rs_mem_sz_region;
 
@@ -249,7 +285,8 @@ private:
 
 public:
   HRRSStatsIter() : _all("All"), _young("Young"), _humongous("Humongous"),
-    _free("Free"), _old("Old"), _max_code_root_mem_sz_region(NULL), _max_rs_mem_sz_region(NULL),
+    _free("Free"), _old("Old"), _sparse("sparse"), _fine("fine"), _coarse("coarse"),
+    _max_code_root_mem_sz_region(NULL), _max_rs_mem_sz_region(NULL),
     _max_rs_mem_sz(0), _max_code_root_mem_sz(0)
   {}
 
@@ -286,6 +323,10 @@ public:
     current->add(rs_mem_sz, occupied_cards, code_root_mem_sz, code_root_elems);
     _all.add(rs_mem_sz, occupied_cards, code_root_mem_sz, code_root_elems);
 
+    _sparse.add(hrrs->sparse_mem_size(), hrrs->occ_sparse(), hrrs->n_sparse_entries());
+    _fine.add(hrrs->fine_mem_size(), hrrs->occ_fine(), hrrs->n_fine_entries());
+    _coarse.add(hrrs->coarse_mem_size(), hrrs->occ_coarse(), hrrs->n_coarse_entries());
+
     return false;
   }
 
@@ -316,6 +357,15 @@ public:
       (*current)->print_cards_occupied_info_on(out, total_cards_occupied());
     }
 
+    size_t total_container_mem_sz = _sparse.mem_size() + _fine.mem_size() + _coarse.mem_size();
+    out->print_cr("   Container sizes = " SIZE_FORMAT "%s.",
+                  byte_size_in_proper_unit(total_container_mem_sz),
+                  proper_unit_for_byte_size(total_container_mem_sz));
+    ContainerTypeCounter* containers[] = { &_sparse, &_fine, &_coarse, NULL };
+    for (ContainerTypeCounter** current = &containers[0]; *current != NULL; current++) {
+      (*current)->print_on(out, total_container_mem_sz, total_cards_occupied());
+    }
+
     // Largest sized rem set region statistics
     HeapRegionRemSet* rem_set = max_rs_mem_sz_region()->rem_set();
     out->print_cr("    Region with largest rem set = " HR_FORMAT ", "
@@ -135,6 +135,13 @@
           "specified number of milliseconds to do miscellaneous work.")     \
           range(0, max_jint)                                                \
                                                                             \
+  product(uintx, G1ConcRefinementControlIntervalMillis, 50,                 \
+          "The primary concurrent refinement thread re-evaluates the "      \
+          "number of refinement threads needed until the next pause at "    \
+          "most every specified number of milliseconds while active. "      \
+          "Only used with G1UseAdaptiveConcRefinement.")                    \
+          range(1, max_jint)                                                \
+                                                                            \
   product(size_t, G1ConcRefinementThresholdStep, 2,                         \
           "Each time the rset update queue increases by this amount "       \
           "activate the next refinement thread if available. "              \
@@ -42,7 +42,7 @@
 const char* HeapRegionRemSet::_state_strings[] =  {"Untracked", "Updating", "Complete"};
 const char* HeapRegionRemSet::_short_state_strings[] =  {"UNTRA", "UPDAT", "CMPLT"};
 
-class PerRegionTable: public CHeapObj<mtGC> {
+class PerRegionTable: public CHeapObj<mtGCCardSet> {
   friend class OtherRegionsTable;
   friend class HeapRegionRemSetIterator;
 
@@ -69,7 +69,7 @@ protected:
   PerRegionTable(HeapRegion* hr) :
     _hr(hr),
     _occupied(0),
-    _bm(HeapRegion::CardsPerRegion, mtGC),
+    _bm(HeapRegion::CardsPerRegion, mtGCCardSet),
     _collision_list_next(NULL), _next(NULL), _prev(NULL)
   {}
 
@@ -241,7 +241,7 @@ size_t OtherRegionsTable::_fine_eviction_sample_size = 0;
 OtherRegionsTable::OtherRegionsTable(HeapRegion* hr, Mutex* m) :
   _g1h(G1CollectedHeap::heap()),
   _hr(hr), _m(m),
-  _coarse_map(G1CollectedHeap::heap()->max_regions(), mtGC),
+  _coarse_map(G1CollectedHeap::heap()->max_regions(), mtGCCardSet),
   _fine_grain_regions(NULL),
   _first_all_fine_prts(NULL), _last_all_fine_prts(NULL),
   _n_fine_entries(0), _n_coarse_entries(0),
@@ -263,7 +263,7 @@ OtherRegionsTable::OtherRegionsTable(HeapRegion* hr, Mutex* m) :
   }
 
   _fine_grain_regions = NEW_C_HEAP_ARRAY3(PerRegionTablePtr, _max_fine_entries,
-                        mtGC, CURRENT_PC, AllocFailStrategy::RETURN_NULL);
+                        mtGCCardSet, CURRENT_PC, AllocFailStrategy::RETURN_NULL);
 
   if (_fine_grain_regions == NULL) {
     vm_exit_out_of_memory(sizeof(void*)*_max_fine_entries, OOM_MALLOC_ERROR,
@@ -543,6 +543,14 @@ size_t OtherRegionsTable::occ_sparse() const {
 }
 
 size_t OtherRegionsTable::mem_size() const {
+  size_t sum = fine_mem_size();
+  sum += coarse_mem_size();
+  sum += sparse_mem_size();
+  sum += sizeof(OtherRegionsTable) - sizeof(_sparse_table); // Avoid double counting above.
+  return sum;
+}
+
+size_t OtherRegionsTable::fine_mem_size() const {
   size_t sum = 0;
   // all PRTs are of the same size so it is sufficient to query only one of them.
   if (_first_all_fine_prts != NULL) {
@@ -551,12 +559,17 @@ size_t OtherRegionsTable::mem_size() const {
     sum += _first_all_fine_prts->mem_size() * _n_fine_entries;
   }
   sum += (sizeof(PerRegionTable*) * _max_fine_entries);
-  sum += (_coarse_map.size_in_words() * HeapWordSize);
-  sum += (_sparse_table.mem_size());
-  sum += sizeof(OtherRegionsTable) - sizeof(_sparse_table); // Avoid double counting above.
   return sum;
 }
 
+size_t OtherRegionsTable::coarse_mem_size() const {
+  return _coarse_map.size_in_words() * HeapWordSize;
+}
+
+size_t OtherRegionsTable::sparse_mem_size() const {
+  return _sparse_table.mem_size();
+}
+
 size_t OtherRegionsTable::static_mem_size() {
   return G1FromCardCache::static_mem_size();
 }
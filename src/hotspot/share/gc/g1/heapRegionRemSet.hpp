@@ -152,10 +152,19 @@ public:
   size_t occ_coarse() const;
   size_t occ_sparse() const;
 
+  // Returns the number of sparse, fine grain and coarsened region entries respectively.
+  size_t n_sparse_entries() const { return _sparse_table.occupied_entries(); }
+  size_t n_fine_entries() const { return _n_fine_entries; }
+  size_t n_coarse_entries() const { return _n_coarse_entries; }
+
   static jint n_coarsenings() { return _n_coarsenings; }
 
   // Returns size of the actual remembered set containers in bytes.
   size_t mem_size() const;
+  // Returns the size of the fine grain, coarse and sparse containers in bytes.
+  size_t fine_mem_size() const;
+  size_t coarse_mem_size() const;
+  size_t sparse_mem_size() const;
   // Returns the size of static data in bytes.
   static size_t static_mem_size();
   // Returns the size of the free list content in bytes.
@@ -211,6 +220,24 @@ public:
   size_t occ_sparse() const {
     return _other_regions.occ_sparse();
   }
+  size_t n_sparse_entries() const {
+    return _other_regions.n_sparse_entries();
+  }
+  size_t n_fine_entries() const {
+    return _other_regions.n_fine_entries();
+  }
+  size_t n_coarse_entries() const {
+    return _other_regions.n_coarse_entries();
+  }
+  size_t fine_mem_size() const {
+    return _other_regions.fine_mem_size();
+  }
+  size_t coarse_mem_size() const {
+    return _other_regions.coarse_mem_size();
+  }
+  size_t sparse_mem_size() const {
+    return _other_regions.sparse_mem_size();
+  }
 
   static jint n_coarsenings() { return OtherRegionsTable::n_coarsenings(); }
 
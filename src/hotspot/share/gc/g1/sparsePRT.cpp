@@ -91,11 +91,11 @@ RSHashTable::RSHashTable(size_t capacity) :
   _capacity(capacity), _capacity_mask(capacity-1),
   _occupied_entries(0), _occupied_cards(0),
   _entries(NULL),
-  _buckets(NEW_C_HEAP_ARRAY(int, capacity, mtGC)),
+  _buckets(NEW_C_HEAP_ARRAY(int, capacity, mtGCCardSet)),
   _free_list(NullEntry), _free_region(0)
 {
   _num_entries = (capacity * TableOccupancyFactor) + 1;
-  _entries = (SparsePRTEntry*)NEW_C_HEAP_ARRAY(char, _num_entries * SparsePRTEntry::size(), mtGC);
+  _entries = (SparsePRTEntry*)NEW_C_HEAP_ARRAY(char, _num_entries * SparsePRTEntry::size(), mtGCCardSet);
   clear();
 }
 
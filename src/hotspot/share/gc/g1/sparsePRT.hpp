@@ -43,7 +43,7 @@
 // insertions only enqueue old versions for deletions, but do not delete
 // old versions synchronously.
 
-class SparsePRTEntry: public CHeapObj<mtGC> {
+class SparsePRTEntry: public CHeapObj<mtGCCardSet> {
 private:
   // The type of a card entry.
   typedef uint16_t card_elem_t;
@@ -109,7 +109,7 @@ public:
   }
 };
 
-class RSHashTable : public CHeapObj<mtGC> {
+class RSHashTable : public CHeapObj<mtGCCardSet> {
 
   friend class RSHashTableIter;
 
@@ -259,6 +259,7 @@ public:
   ~SparsePRT();
 
   size_t occupied() const { return _next->occupied_cards(); }
+  size_t occupied_entries() const { return _next->occupied_entries(); }
   size_t mem_size() const;
 
   // Attempts to ensure that the given card_index in the given region is in
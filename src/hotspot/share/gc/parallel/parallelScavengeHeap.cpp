@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
 #include "code/codeCache.hpp"
 #include "gc/parallel/adjoiningGenerations.hpp"
 #include "gc/parallel/adjoiningVirtualSpaces.hpp"
@@ -36,10 +37,12 @@
 #include "gc/parallel/psParallelCompact.inline.hpp"
 #include "gc/parallel/psPromotionManager.hpp"
 #include "gc/parallel/psScavenge.hpp"
+#include "gc/parallel/psStringDedup.hpp"
 #include "gc/parallel/vmPSOperations.hpp"
 #include "gc/shared/gcHeapSummary.hpp"
 #include "gc/shared/gcLocker.hpp"
 #include "gc/shared/gcWhen.hpp"
+#include "gc/shared/suspendibleThreadSet.hpp"
 #include "logging/log.hpp"
 #include "memory/iterator.hpp"
 #include "memory/metaspaceCounters.hpp"
@@ -160,6 +163,33 @@ void ParallelScavengeHeap::post_initialize() {
     PSMarkSweepProxy::initialize();
   }
   PSPromotionManager::initialize();
+  PSStringDedup::initialize();
+}
+
+void ParallelScavengeHeap::stop() {
+  if (PSStringDedup::is_enabled()) {
+    PSStringDedup::stop();
+  }
+}
+
+void ParallelScavengeHeap::safepoint_synchronize_begin() {
+  if (PSStringDedup::is_enabled()) {
+    SuspendibleThreadSet::synchronize();
+  }
+}
+
+void ParallelScavengeHeap::safepoint_synchronize_end() {
+  if (PSStringDedup::is_enabled()) {
+    SuspendibleThreadSet::desynchronize();
+  }
+}
+
+void ParallelScavengeHeap::deduplicate_string(oop str) {
+  assert(java_lang_String::is_instance(str), "invariant");
+
+  if (PSStringDedup::is_enabled()) {
+    PSStringDedup::deduplicate(str);
+  }
 }
 
 void ParallelScavengeHeap::update_counters() {
@@ -598,10 +628,16 @@ void ParallelScavengeHeap::print_on_error(outputStream* st) const {
 
 void ParallelScavengeHeap::gc_threads_do(ThreadClosure* tc) const {
   PSScavenge::gc_task_manager()->threads_do(tc);
+  if (PSStringDedup::is_enabled()) {
+    PSStringDedup::threads_do(tc);
+  }
 }
 
 void ParallelScavengeHeap::print_gc_threads_on(outputStream* st) const {
   PSScavenge::gc_task_manager()->print_threads_on(st);
+  if (PSStringDedup::is_enabled()) {
+    PSStringDedup::print_worker_threads_on(st);
+  }
 }
 
 void ParallelScavengeHeap::print_tracing_info() const {
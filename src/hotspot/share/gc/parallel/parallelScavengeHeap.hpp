@@ -138,6 +138,11 @@ class ParallelScavengeHeap : public CollectedHeap {
   virtual jint initialize();
 
   void post_initialize();
+  virtual void stop();
+
+  // The string deduplication thread joins the suspendible thread set.
+  virtual void safepoint_synchronize_begin();
+  virtual void safepoint_synchronize_end();
   void update_counters();
 
   // The alignment used for the various areas
@@ -234,6 +239,8 @@ class ParallelScavengeHeap : public CollectedHeap {
   virtual void gc_threads_do(ThreadClosure* tc) const;
   virtual void print_tracing_info() const;
 
+  virtual void deduplicate_string(oop str);
+
   void verify(VerifyOption option /* ignored */);
 
   // Resize the young generation.  The reserved space for the
@@ -34,6 +34,7 @@
 #include "gc/parallel/psMarkSweepDecorator.hpp"
 #include "gc/parallel/psOldGen.hpp"
 #include "gc/parallel/psScavenge.hpp"
+#include "gc/parallel/psStringDedup.hpp"
 #include "gc/parallel/psYoungGen.hpp"
 #include "gc/serial/markSweep.hpp"
 #include "gc/shared/gcCause.hpp"
@@ -568,6 +569,11 @@ void PSMarkSweep::mark_sweep_phase1(bool clear_all_softrefs) {
     StringTable::unlink(is_alive_closure());
   }
 
+  if (PSStringDedup::is_enabled()) {
+    GCTraceTime(Debug, gc, phases) t("String Dedup Unlink", _gc_timer);
+    PSStringDedup::unlink_or_oops_do(is_alive_closure(), NULL, true);
+  }
+
   {
     GCTraceTime(Debug, gc, phases) t("Scrub Symbol Table", _gc_timer);
     // Clean up unreferenced symbols in symbol table.
@@ -627,6 +633,9 @@ void PSMarkSweep::mark_sweep_phase3() {
   CodeCache::blobs_do(&adjust_from_blobs);
   AOTLoader::oops_do(adjust_pointer_closure());
   StringTable::oops_do(adjust_pointer_closure());
+  if (PSStringDedup::is_enabled()) {
+    PSStringDedup::oops_do(adjust_pointer_closure());
+  }
   ref_processor()->weak_oops_do(adjust_pointer_closure());
   PSScavenge::reference_processor()->weak_oops_do(adjust_pointer_closure());
 
@@ -39,6 +39,7 @@
 #include "gc/parallel/psParallelCompact.inline.hpp"
 #include "gc/parallel/psPromotionManager.inline.hpp"
 #include "gc/parallel/psScavenge.hpp"
+#include "gc/parallel/psStringDedup.hpp"
 #include "gc/parallel/psYoungGen.hpp"
 #include "gc/shared/gcCause.hpp"
 #include "gc/shared/gcHeapSummary.hpp"
@@ -2162,6 +2163,11 @@ void PSParallelCompact::marking_phase(ParCompactionManager* cm,
     StringTable::unlink(is_alive_closure());
   }
 
+  if (PSStringDedup::is_enabled()) {
+    GCTraceTime(Debug, gc, phases) t("String Dedup Unlink", &_gc_timer);
+    PSStringDedup::parallel_unlink_or_oops_do(is_alive_closure(), false /* from_scavenge */);
+  }
+
   {
     GCTraceTime(Debug, gc, phases) t("Scrub Symbol Table", &_gc_timer);
     // Clean up unreferenced symbols in symbol table.
@@ -2198,6 +2204,9 @@ void PSParallelCompact::adjust_roots(ParCompactionManager* cm) {
   CodeCache::blobs_do(&adjust_from_blobs);
   AOTLoader::oops_do(&oop_closure);
   StringTable::oops_do(&oop_closure);
+  if (PSStringDedup::is_enabled()) {
+    PSStringDedup::oops_do(&oop_closure);
+  }
   ref_processor()->weak_oops_do(&oop_closure);
   // Roots were visited so references into the young gen in roots
   // may have been scanned.  Process them also.
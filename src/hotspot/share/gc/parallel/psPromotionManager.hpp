@@ -88,6 +88,10 @@ class PSPromotionManager {
   PreservedMarks*                     _preserved_marks;
   PromotionFailedInfo                 _promotion_failed_info;
 
+  // Index of this manager in _manager_array, used as the worker id when
+  // pushing string deduplication candidates.
+  uint                                _worker_id;
+
   // Accessors
   static PSOldGen* old_gen()         { return _old_gen; }
   static MutableSpace* young_space() { return _young_space; }
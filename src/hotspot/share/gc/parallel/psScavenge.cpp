@@ -31,6 +31,7 @@
 #include "gc/parallel/psMarkSweepProxy.hpp"
 #include "gc/parallel/psParallelCompact.inline.hpp"
 #include "gc/parallel/psScavenge.inline.hpp"
+#include "gc/parallel/psStringDedup.hpp"
 #include "gc/parallel/psTasks.hpp"
 #include "gc/shared/collectorPolicy.hpp"
 #include "gc/shared/gcCause.hpp"
@@ -437,6 +438,13 @@ bool PSScavenge::invoke_no_policy() {
       StringTable::unlink_or_oops_do(&_is_alive_closure, &root_closure);
     }
 
+    if (PSStringDedup::is_enabled()) {
+      GCTraceTime(Debug, gc, phases) tm("String Dedup Fixup", &_gc_timer);
+      // Unlink dead deduplication candidates and table entries, and
+      // update the remaining ones to the forwarded copies.
+      PSStringDedup::parallel_unlink_or_oops_do(&_is_alive_closure, true /* from_scavenge */);
+    }
+
     // Verify that usage of root_closure didn't copy any objects.
     assert(promotion_manager->stacks_empty(),"stacks should be empty at this point");
 
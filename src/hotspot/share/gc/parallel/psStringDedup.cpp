@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2014, 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.inline.hpp"
+#include "gc/parallel/gcTaskManager.hpp"
+#include "gc/parallel/parallelScavengeHeap.hpp"
+#include "gc/parallel/psPromotionManager.inline.hpp"
+#include "gc/parallel/psScavenge.inline.hpp"
+#include "gc/parallel/psStringDedup.hpp"
+#include "gc/shared/stringdedup/stringDedup.inline.hpp"
+#include "gc/shared/stringdedup/stringDedupQueue.hpp"
+#include "gc/shared/stringdedup/stringDedupStat.hpp"
+#include "gc/shared/stringdedup/stringDedupTable.hpp"
+#include "gc/shared/stringdedup/stringDedupThread.inline.hpp"
+#include "gc/shared/stringdedup/stringDedupWorkerQueue.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/safepoint.hpp"
+
+void PSStringDedup::initialize() {
+  assert(UseParallelGC, "String deduplication available with Parallel");
+  StringDedup::initialize_impl<StringDedupWorkerQueue, StringDedupStat>();
+}
+
+bool PSStringDedup::is_candidate_from_scavenge(bool to_young, oop obj) {
+  if (java_lang_String::is_instance_inlined(obj)) {
+    if (to_young && obj->age() == StringDeduplicationAgeThreshold) {
+      // Candidate found. String is being scavenged to the survivor space
+      // and just reached the deduplication age threshold.
+      return true;
+    }
+    if (!to_young && obj->age() < StringDeduplicationAgeThreshold) {
+      // Candidate found. String is being promoted but has not reached the
+      // deduplication age threshold, i.e. has not previously been a
+      // candidate during its life in the young generation.
+      return true;
+    }
+  }
+
+  // Not a candidate
+  return false;
+}
+
+void PSStringDedup::enqueue_from_scavenge(bool to_young, uint worker_id, oop java_string, oop new_obj) {
+  assert(is_enabled(), "String deduplication not enabled");
+  if (is_candidate_from_scavenge(to_young, new_obj)) {
+    StringDedupQueue::push(worker_id, java_string);
+  }
+}
+
+void PSStringDedup::unlink_or_oops_do(BoolObjectClosure* is_alive,
+                                      OopClosure* keep_alive,
+                                      bool allow_resize_and_rehash) {
+  assert(is_enabled(), "String deduplication not enabled");
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at a safepoint");
+
+  StringDedupUnlinkOrOopsDoClosure cl(is_alive, keep_alive);
+  gc_prologue(allow_resize_and_rehash);
+  StringDedupQueue::unlink_or_oops_do(&cl);
+  StringDedupTable::unlink_or_oops_do(&cl, 0);
+  gc_epilogue();
+}
+
+void PSStringDedup::oops_do(OopClosure* keep_alive) {
+  unlink_or_oops_do(NULL, keep_alive, false /* allow_resize_and_rehash */);
+}
+
+//
+// Task for parallel unlink_or_oops_do() operation on the deduplication queue
+// and table. Queues and table partitions are claimed by the workers.
+//
+class PSStringDedupUnlinkOrOopsDoTask : public GCTask {
+private:
+  BoolObjectClosure* _is_alive;
+  bool               _from_scavenge;
+
+public:
+  PSStringDedupUnlinkOrOopsDoTask(BoolObjectClosure* is_alive, bool from_scavenge) :
+    _is_alive(is_alive), _from_scavenge(from_scavenge) { }
+
+  char* name() { return (char *)"string-dedup-unlink-task"; }
+
+  virtual void do_it(GCTaskManager* manager, uint which) {
+    if (_from_scavenge) {
+      PSPromotionManager* pm = PSPromotionManager::gc_thread_promotion_manager(which);
+      PSScavengeRootsClosure keep_alive(pm);
+      StringDedupUnlinkOrOopsDoClosure cl(_is_alive, &keep_alive);
+      PSStringDedup::parallel_unlink(&cl, which);
+      // Live entries are already forwarded, nothing has been copied.
+      assert(pm->stacks_empty(), "stacks should be empty at this point");
+    } else {
+      StringDedupUnlinkOrOopsDoClosure cl(_is_alive, NULL);
+      PSStringDedup::parallel_unlink(&cl, which);
+    }
+  }
+};
+
+void PSStringDedup::parallel_unlink_or_oops_do(BoolObjectClosure* is_alive, bool from_scavenge) {
+  assert(is_enabled(), "String deduplication not enabled");
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at a safepoint");
+
+  GCTaskManager* manager = ParallelScavengeHeap::gc_task_manager();
+  uint active_workers = manager->active_workers();
+
+  gc_prologue(true /* allow_resize_and_rehash */);
+  GCTaskQueue* q = GCTaskQueue::create();
+  for (uint i = 0; i < active_workers; i++) {
+    q->enqueue(new PSStringDedupUnlinkOrOopsDoTask(is_alive, from_scavenge));
+  }
+  manager->execute_and_wait(q);
+  gc_epilogue();
+}
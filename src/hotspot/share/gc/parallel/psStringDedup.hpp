@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2014, 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_PARALLEL_PSSTRINGDEDUP_HPP
+#define SHARE_VM_GC_PARALLEL_PSSTRINGDEDUP_HPP
+
+//
+// Parallel string deduplication candidate selection
+//
+// An object is considered a deduplication candidate if all of the following
+// statements are true:
+//
+// - The object is an instance of java.lang.String
+//
+// - The object is being scavenged to the survivor space and the object's
+//   age is equal to the deduplication age threshold
+//
+//   or
+//
+//   The object is being promoted to the old generation and the object's age
+//   is less than the deduplication age threshold
+//
+// This mirrors the selection done by G1 during evacuation. Strings moved by
+// a full collection are not considered, they have either already been a
+// candidate or will become one at their next scavenge.
+//
+
+#include "gc/shared/stringdedup/stringDedup.hpp"
+#include "memory/allocation.hpp"
+#include "oops/oop.hpp"
+
+class BoolObjectClosure;
+class OopClosure;
+
+//
+// Parallel interface for interacting with string deduplication.
+//
+class PSStringDedup : public StringDedup {
+private:
+  // Candidate selection policy, returns true if the given object is
+  // candidate for string deduplication.
+  static bool is_candidate_from_scavenge(bool to_young, oop obj);
+
+public:
+  // Initialize string deduplication.
+  static void initialize();
+
+  // Enqueues a deduplication candidate for later processing by the deduplication
+  // thread. Before enqueuing, this function applies the candidate selection
+  // policy to filter out non-candidates. The string must be the from-space
+  // copy, which the weak processing at the end of the scavenge updates to
+  // its forwardee.
+  static void enqueue_from_scavenge(bool to_young, uint worker_id, oop java_string, oop new_obj);
+
+  // Unlinks dead entries and applies keep_alive to live entries in the
+  // deduplication queue and table. Single threaded, called by the VM thread
+  // during a serial full collection and when adjusting pointers.
+  static void unlink_or_oops_do(BoolObjectClosure* is_alive, OopClosure* keep_alive,
+                                bool allow_resize_and_rehash);
+  static void oops_do(OopClosure* keep_alive);
+
+  // Unlinks dead entries in the deduplication queue and table using the
+  // active GC task manager workers. From a scavenge, live entries are also
+  // updated to their forwardees, using the promotion manager of each worker.
+  static void parallel_unlink_or_oops_do(BoolObjectClosure* is_alive, bool from_scavenge);
+};
+
+#endif // SHARE_VM_GC_PARALLEL_PSSTRINGDEDUP_HPP
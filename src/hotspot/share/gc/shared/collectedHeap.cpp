@@ -63,14 +63,24 @@ void EventLogBase<GCMessage>::print(outputStream* st, GCMessage& m) {
   st->print_raw(m);
 }
 
+template <>
+void EventLogBase<GCMessage>::copy(GCMessage& dst, GCMessage& src) {
+  dst.is_before = src.is_before;
+  memcpy(dst.buffer(), src.buffer(), dst.size() - 1);
+  dst.buffer()[dst.size() - 1] = '\0';
+}
+
 void GCHeapLog::log_heap(CollectedHeap* heap, bool before) {
   if (!should_log()) {
     return;
   }
 
   double timestamp = fetch_timestamp();
-  MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
-  int index = compute_log_index();
+  size_t ticket;
+  int index = claim_log_index(&ticket);
+  if (index < 0) {
+    return;
+  }
   _records[index].thread = NULL; // Its the GC thread so it's not that interesting.
   _records[index].timestamp = timestamp;
   _records[index].data.is_before = before;
@@ -83,6 +93,7 @@ void GCHeapLog::log_heap(CollectedHeap* heap, bool before) {
 
   heap->print_on(&st);
   st.print_cr("}");
+  commit_log_index(index, ticket);
 }
 
 VirtualSpaceSummary CollectedHeap::create_heap_space_summary() {
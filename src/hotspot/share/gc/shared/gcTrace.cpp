@@ -287,6 +287,24 @@ void G1NewTracer::report_adaptive_ihop_statistics(size_t threshold,
                                 prediction_active);
 }
 
+void G1NewTracer::report_concurrent_refinement_statistics(size_t pending_buffers,
+                                                          size_t green_zone,
+                                                          size_t yellow_zone,
+                                                          size_t red_zone,
+                                                          double incoming_buffer_rate,
+                                                          double predicted_time_to_gc,
+                                                          double predicted_buffer_cost,
+                                                          uint wanted_threads) {
+  send_concurrent_refinement_statistics(pending_buffers,
+                                        green_zone,
+                                        yellow_zone,
+                                        red_zone,
+                                        incoming_buffer_rate,
+                                        predicted_time_to_gc,
+                                        predicted_buffer_cost,
+                                        wanted_threads);
+}
+
 void G1OldTracer::report_gc_start_impl(GCCause::Cause cause, const Ticks& timestamp) {
   _shared_gc_info.set_start_timestamp(timestamp);
 }
@@ -267,6 +267,14 @@ class G1NewTracer : public YoungGCTracer {
                                        double predicted_allocation_rate,
                                        double predicted_marking_length,
                                        bool prediction_active);
+  void report_concurrent_refinement_statistics(size_t pending_buffers,
+                                               size_t green_zone,
+                                               size_t yellow_zone,
+                                               size_t red_zone,
+                                               double incoming_buffer_rate,
+                                               double predicted_time_to_gc,
+                                               double predicted_buffer_cost,
+                                               uint wanted_threads);
  private:
   void send_g1_young_gc_event();
   void send_evacuation_info_event(EvacuationInfo* info);
@@ -288,6 +296,14 @@ class G1NewTracer : public YoungGCTracer {
                                      double predicted_allocation_rate,
                                      double predicted_marking_length,
                                      bool prediction_active);
+  void send_concurrent_refinement_statistics(size_t pending_buffers,
+                                             size_t green_zone,
+                                             size_t yellow_zone,
+                                             size_t red_zone,
+                                             double incoming_buffer_rate,
+                                             double predicted_time_to_gc,
+                                             double predicted_buffer_cost,
+                                             uint wanted_threads);
 };
 
 class G1FullGCTracer : public OldGCTracer {
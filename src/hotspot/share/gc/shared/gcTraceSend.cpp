@@ -309,6 +309,29 @@ void G1NewTracer::send_adaptive_ihop_statistics(size_t threshold,
   }
 }
 
+void G1NewTracer::send_concurrent_refinement_statistics(size_t pending_buffers,
+                                                        size_t green_zone,
+                                                        size_t yellow_zone,
+                                                        size_t red_zone,
+                                                        double incoming_buffer_rate,
+                                                        double predicted_time_to_gc,
+                                                        double predicted_buffer_cost,
+                                                        uint wanted_threads) {
+  EventG1ConcurrentRefinementControl evt;
+  if (evt.should_commit()) {
+    evt.set_gcId(GCId::current());
+    evt.set_pendingBuffers(pending_buffers);
+    evt.set_greenZone(green_zone);
+    evt.set_yellowZone(yellow_zone);
+    evt.set_redZone(red_zone);
+    evt.set_incomingBufferRate(incoming_buffer_rate * MILLIUNITS);
+    evt.set_predictedTimeToNextGC((s8)predicted_time_to_gc);
+    evt.set_predictedBufferCost(predicted_buffer_cost);
+    evt.set_wantedThreads(wanted_threads);
+    evt.commit();
+  }
+}
+
 #endif // INCLUDE_G1GC
 
 static JfrStructVirtualSpace to_struct(const VirtualSpaceSummary& summary) {
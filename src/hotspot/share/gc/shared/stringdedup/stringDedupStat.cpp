@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/shared/stringdedup/stringDedupStat.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
 
 StringDedupStat::StringDedupStat() :
@@ -150,3 +151,20 @@ void StringDedupStat::print_statistics(bool total) const {
   log_debug(gc, stringdedup)("    Deduplicated: " STRDEDUP_OBJECTS_FORMAT "(" STRDEDUP_PERCENT_FORMAT ") " STRDEDUP_BYTES_FORMAT "(" STRDEDUP_PERCENT_FORMAT ")",
                              _deduped, deduped_percent, STRDEDUP_BYTES_PARAM(_deduped_bytes), deduped_bytes_percent);
 }
+
+void StringDedupStat::send_event() const {
+  EventStringDeduplication e;
+  if (e.should_commit()) {
+    e.set_inspected(_inspected);
+    e.set_skipped(_skipped);
+    e.set_hashed(_hashed);
+    e.set_known(_known);
+    e.set_newStrings(_new);
+    e.set_newBytes(_new_bytes);
+    e.set_deduplicated(_deduped);
+    e.set_deduplicatedBytes(_deduped_bytes);
+    e.set_executionTime((jlong)(_exec_elapsed * MILLIUNITS));
+    e.set_blockedTime((jlong)(_block_elapsed * MILLIUNITS));
+    e.commit();
+  }
+}
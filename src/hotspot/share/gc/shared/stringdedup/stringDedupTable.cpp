@@ -27,6 +27,7 @@
 #include "classfile/javaClasses.inline.hpp"
 #include "gc/shared/stringdedup/stringDedup.hpp"
 #include "gc/shared/stringdedup/stringDedupTable.hpp"
+#include "gc/shared/stringdedup/stringDedupThread.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
 #include "logging/log.hpp"
 #include "memory/padded.inline.hpp"
@@ -34,7 +35,8 @@
 #include "oops/arrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.hpp"
-#include "runtime/mutexLocker.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/orderAccess.hpp"
 #include "runtime/safepointVerifiers.hpp"
 
 //
@@ -89,8 +91,8 @@ public:
 // later reuse or free the underlying memory for these entries.
 //
 // The cache allows for single-threaded allocations and multi-threaded frees.
-// Allocations are synchronized by StringDedupTable_lock as part of a table
-// modification.
+// Allocations are only done by the deduplication thread, other threads adding
+// table entries bypass the cache.
 //
 class StringDedupEntryCache : public CHeapObj<mtGC> {
 private:
@@ -243,14 +245,40 @@ void StringDedupTable::create() {
   _table = new StringDedupTable(_min_size);
 }
 
-void StringDedupTable::add(typeArrayOop value, bool latin1, unsigned int hash, StringDedupEntry** list) {
-  StringDedupEntry* entry = _entry_cache->alloc();
+typeArrayOop StringDedupTable::add(typeArrayOop value, bool latin1, unsigned int hash,
+                                   StringDedupEntry** list, StringDedupEntry* head, uintx &count) {
+  // Only the deduplication thread allocates from the entry cache, other
+  // threads (e.g. when deduplicating strings before interning them)
+  // allocate their entries directly.
+  StringDedupEntry* entry;
+  if (Thread::current() == StringDedupThread::thread()) {
+    entry = _entry_cache->alloc();
+  } else {
+    entry = new StringDedupEntry();
+  }
   entry->set_obj(value);
   entry->set_hash(hash);
   entry->set_latin1(latin1);
-  entry->set_next(*list);
-  *list = entry;
-  _entries++;
+
+  for (;;) {
+    entry->set_next(head);
+    StringDedupEntry* prev = Atomic::cmpxchg(entry, list, head);
+    if (prev == head) {
+      // Published
+      Atomic::inc(&_entries);
+      return NULL;
+    }
+
+    // Lost the race, only the entries added since head was read
+    // need to be checked for a match.
+    typeArrayOop existing_value = lookup(value, latin1, hash, prev, head, count);
+    if (existing_value != NULL) {
+      entry->set_obj(NULL);
+      delete entry;
+      return existing_value;
+    }
+    head = prev;
+  }
 }
 
 void StringDedupTable::remove(StringDedupEntry** pentry, uint worker_id) {
@@ -278,8 +306,8 @@ bool StringDedupTable::equals(typeArrayOop value1, typeArrayOop value2) {
 }
 
 typeArrayOop StringDedupTable::lookup(typeArrayOop value, bool latin1, unsigned int hash,
-                                      StringDedupEntry** list, uintx &count) {
-  for (StringDedupEntry* entry = *list; entry != NULL; entry = entry->next()) {
+                                      StringDedupEntry* entry, StringDedupEntry* stop, uintx &count) {
+  for (; entry != stop; entry = entry->next()) {
     if (entry->hash() == hash && entry->latin1() == latin1) {
       oop* obj_addr = (oop*)entry->obj_addr();
       oop obj = NativeAccess<ON_PHANTOM_OOP_REF | AS_NO_KEEPALIVE>::oop_load(obj_addr);
@@ -298,22 +326,24 @@ typeArrayOop StringDedupTable::lookup(typeArrayOop value, bool latin1, unsigned
 typeArrayOop StringDedupTable::lookup_or_add_inner(typeArrayOop value, bool latin1, unsigned int hash) {
   size_t index = hash_to_index(hash);
   StringDedupEntry** list = bucket(index);
+  StringDedupEntry* head = OrderAccess::load_acquire(list);
   uintx count = 0;
 
   // Lookup in list
-  typeArrayOop existing_value = lookup(value, latin1, hash, list, count);
-
-  // Check if rehash is needed
-  if (count > _rehash_threshold) {
-    _rehash_needed = true;
-  }
+  typeArrayOop existing_value = lookup(value, latin1, hash, head, NULL, count);
 
   if (existing_value == NULL) {
     // Not found, add new entry
-    add(value, latin1, hash, list);
+    existing_value = add(value, latin1, hash, list, head, count);
+    if (existing_value == NULL) {
+      // Update statistics
+      Atomic::inc(&_entries_added);
+    }
+  }
 
-    // Update statistics
-    _entries_added++;
+  // Check if rehash is needed
+  if (count > _rehash_threshold) {
+    _rehash_needed = true;
   }
 
   return existing_value;
@@ -488,11 +518,10 @@ void StringDedupTable::unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl, u
     removed += unlink_or_oops_do(cl, table_half + partition_begin, table_half + partition_end, worker_id);
   }
 
-  // Delayed update to avoid contention on the table lock
+  // Delayed update to avoid contention on the counters
   if (removed > 0) {
-    MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
-    _table->_entries -= removed;
-    _entries_removed += removed;
+    Atomic::sub(removed, &_table->_entries);
+    Atomic::add(removed, &_entries_removed);
   }
 }
 
@@ -26,7 +26,8 @@
 #define SHARE_VM_GC_SHARED_STRINGDEDUP_STRINGDEDUPTABLE_HPP
 
 #include "gc/shared/stringdedup/stringDedupStat.hpp"
-#include "runtime/mutexLocker.hpp"
+#include "memory/allocation.hpp"
+#include "oops/typeArrayOop.hpp"
 
 class StringDedupEntryCache;
 class StringDedupUnlinkOrOopsDoClosure;
@@ -105,11 +106,14 @@ public:
 // The table is also dynamically rehashed (using a new hash seed) if it becomes severely
 // unbalanced, i.e., a hash chain is significantly longer than average.
 //
-// All access to the table is protected by the StringDedupTable_lock, except under
-// safepoints in which case GC workers are allowed to access a table partitions they
-// have claimed without first acquiring the lock. Note however, that this applies only
-// the table partition (i.e. a range of elements in _buckets), not other parts of the
-// table such as the _entries field, statistics counters, etc.
+// Outside of safepoints entries are only ever added to the table, never removed,
+// and the active table instance is never replaced. Lookups therefore walk the hash
+// chains without locking, and new entries are published by atomically swapping
+// them in at the head of their bucket. Removal, resizing and rehashing only happen
+// under safepoints, in which case GC workers are allowed to access the table
+// partitions they have claimed without synchronization. Note however, that this
+// applies only to the table partition (i.e. a range of elements in _buckets), not
+// other parts of the table such as the _entries field, statistics counters, etc.
 //
 class StringDedupTable : public CHeapObj<mtGC> {
 private:
@@ -166,8 +170,11 @@ private:
     return (size_t)hash & (_size - 1);
   }
 
-  // Adds a new table entry to the given hash bucket.
-  void add(typeArrayOop value, bool latin1, unsigned int hash, StringDedupEntry** list);
+  // Adds a new table entry to the given hash bucket, unless another thread
+  // concurrently added a matching entry. Returns the existing character
+  // array in that case, otherwise NULL.
+  typeArrayOop add(typeArrayOop value, bool latin1, unsigned int hash,
+                   StringDedupEntry** list, StringDedupEntry* head, uintx &count);
 
   // Removes the given table entry from the table.
   void remove(StringDedupEntry** pentry, uint worker_id);
@@ -175,21 +182,20 @@ private:
   // Transfers a table entry from the current table to the destination table.
   void transfer(StringDedupEntry** pentry, StringDedupTable* dest);
 
-  // Returns an existing character array in the given hash bucket, or NULL
-  // if no matching character array exists.
+  // Returns an existing character array in the hash chain starting at the
+  // given entry and ending before the given stop entry, or NULL if no
+  // matching character array exists.
   typeArrayOop lookup(typeArrayOop value, bool latin1, unsigned int hash,
-                      StringDedupEntry** list, uintx &count);
+                      StringDedupEntry* entry, StringDedupEntry* stop, uintx &count);
 
   // Returns an existing character array in the table, or inserts a new
   // table entry if no matching character array exists.
   typeArrayOop lookup_or_add_inner(typeArrayOop value, bool latin1, unsigned int hash);
 
-  // Thread safe lookup or add of table entry
+  // Thread safe lookup or add of table entry. The caller must not block
+  // for a safepoint, since _table can only be replaced by a new instance
+  // (after a resize or rehash) while at a safepoint.
   static typeArrayOop lookup_or_add(typeArrayOop value, bool latin1, unsigned int hash) {
-    // Protect the table from concurrent access. Also note that this lock
-    // acts as a fence for _table, which could have been replaced by a new
-    // instance if the table was resized or rehashed.
-    MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
     return _table->lookup_or_add_inner(value, latin1, hash);
   }
 
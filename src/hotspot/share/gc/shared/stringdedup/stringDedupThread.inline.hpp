@@ -75,6 +75,7 @@ void StringDedupThreadImpl<S>::do_deduplication() {
 
       total_stat.add(&stat);
       print_end(&stat, &total_stat);
+      stat.send_event();
       stat.reset();
     }
 
@@ -22,8 +22,8 @@
  *
  */
 
-#ifndef SHARE_VM_GC_G1_G1STRINGDEDUPQUEUE_HPP
-#define SHARE_VM_GC_G1_G1STRINGDEDUPQUEUE_HPP
+#ifndef SHARE_VM_GC_SHARED_STRINGDEDUP_STRINGDEDUPWORKERQUEUE_HPP
+#define SHARE_VM_GC_SHARED_STRINGDEDUP_STRINGDEDUPWORKERQUEUE_HPP
 
 #include "gc/shared/stringdedup/stringDedupQueue.hpp"
 #include "memory/allocation.hpp"
@@ -33,17 +33,20 @@
 class StringDedupUnlinkOrOopsDoClosure;
 
 //
-// G1 enqueues candidates during the stop-the-world mark/evacuation phase.
+// Queue for collectors that enqueue candidates during stop-the-world
+// mark/evacuation phases (G1 and Parallel). There is one queue per GC
+// worker, plus one for the VM thread, which evacuates objects itself
+// when reference processing is done single threaded.
 //
 
-class G1StringDedupQueue : public StringDedupQueue {
+class StringDedupWorkerQueue : public StringDedupQueue {
 private:
-  typedef Stack<oop, mtGC> G1StringDedupWorkerQueue;
+  typedef Stack<oop, mtGC> WorkerStack;
 
   static const size_t        _max_size;
   static const size_t        _max_cache_size;
 
-  G1StringDedupWorkerQueue*  _queues;
+  WorkerStack*               _queues;
   size_t                     _nqueues;
   size_t                     _cursor;
   bool                       _cancel;
@@ -52,12 +55,12 @@ private:
   // Statistics counter, only used for logging.
   uintx                      _dropped;
 
-  ~G1StringDedupQueue();
+  ~StringDedupWorkerQueue();
 
   void unlink_or_oops_do(StringDedupUnlinkOrOopsDoClosure* cl, size_t queue);
 
 public:
-  G1StringDedupQueue();
+  StringDedupWorkerQueue();
 
 protected:
 
@@ -84,4 +87,4 @@ protected:
   void verify_impl();
 };
 
-#endif // SHARE_VM_GC_G1_G1STRINGDEDUPQUEUE_HPP
+#endif // SHARE_VM_GC_SHARED_STRINGDEDUP_STRINGDEDUPWORKERQUEUE_HPP
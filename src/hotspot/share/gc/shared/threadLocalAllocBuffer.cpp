@@ -107,6 +107,13 @@ void ThreadLocalAllocBuffer::accumulate_statistics() {
     assert(_number_of_refills == 0 && _fast_refill_waste == 0 &&
            _slow_refill_waste == 0 && _gc_waste          == 0,
            "tlab stats == 0");
+    // The thread did not allocate at all since the last GC. Decay its
+    // allocation fraction so that the next resize shrinks its desired
+    // size instead of keeping eden reserved for a TLAB that is never used.
+    if (allocated_since_last_gc == 0 && used > 0.5 * capacity) {
+      _allocation_fraction.sample(0.0f);
+      global_stats()->update_idle_threads();
+    }
   }
   global_stats()->update_slow_allocations(_slow_allocations);
 }
@@ -186,6 +193,19 @@ void ThreadLocalAllocBuffer::fill(HeapWord* start,
 
   initialize(start, top, start + new_size - alignment_reserve());
 
+  // A thread that has already used up its target number of refills
+  // allocates faster than its share of eden predicted at the last GC.
+  // Grow its desired size now rather than waiting for the next resize.
+  if (ResizeTLAB && _number_of_refills % _target_refills == 0 &&
+      desired_size() < max_size()) {
+    size_t new_desired_size = align_object_size(MIN2(desired_size() * 2, max_size()));
+    log_trace(gc, tlab)("TLAB grow: thread: " INTPTR_FORMAT " [id: %2d]"
+                        " refills %d desired_size: " SIZE_FORMAT " -> " SIZE_FORMAT,
+                        p2i(myThread()), myThread()->osthread()->thread_id(),
+                        _number_of_refills, desired_size(), new_desired_size);
+    set_desired_size(new_desired_size);
+  }
+
   // Reset amount of internal fragmentation
   set_refill_waste_limit(initial_refill_waste_limit());
 }
@@ -415,6 +435,7 @@ GlobalTLABStats::GlobalTLABStats() :
 void GlobalTLABStats::initialize() {
   // Clear counters summarizing info from all threads
   _allocating_threads      = 0;
+  _idle_threads            = 0;
   _total_refills           = 0;
   _max_refills             = 0;
   _total_allocation        = 0;
@@ -454,15 +475,15 @@ void GlobalTLABStats::print() {
 
   size_t waste = _total_gc_waste + _total_slow_refill_waste + _total_fast_refill_waste;
   double waste_percent = percent_of(waste, _total_allocation);
-  log.debug("TLAB totals: thrds: %d  refills: %d max: %d"
-            " slow allocs: %d max %d waste: %4.1f%%"
+  log.debug("TLAB totals: thrds: %d idle: %d  refills: %d max: %d"
+            " slow allocs: %d max %d waste: %4.1f%% (" SIZE_FORMAT "B)"
             " gc: " SIZE_FORMAT "B max: " SIZE_FORMAT "B"
             " slow: " SIZE_FORMAT "B max: " SIZE_FORMAT "B"
             " fast: " SIZE_FORMAT "B max: " SIZE_FORMAT "B",
-            _allocating_threads,
+            _allocating_threads, _idle_threads,
             _total_refills, _max_refills,
             _total_slow_allocations, _max_slow_allocations,
-            waste_percent,
+            waste_percent, waste * HeapWordSize,
             _total_gc_waste * HeapWordSize,
             _max_gc_waste * HeapWordSize,
             _total_slow_refill_waste * HeapWordSize,
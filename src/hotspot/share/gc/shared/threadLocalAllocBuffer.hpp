@@ -213,6 +213,7 @@ private:
   // PerfData should be write-only for security reasons
   // (see perfData.hpp)
   unsigned _allocating_threads;
+  unsigned _idle_threads;
   unsigned _total_refills;
   unsigned _max_refills;
   size_t   _total_allocation;
@@ -265,6 +266,9 @@ public:
   void update_allocating_threads() {
     _allocating_threads++;
   }
+  void update_idle_threads() {
+    _idle_threads++;
+  }
   void update_number_of_refills(unsigned value) {
     _total_refills += value;
     _max_refills    = MAX2(_max_refills, value);
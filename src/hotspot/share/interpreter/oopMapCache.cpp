@@ -40,6 +40,8 @@ class OopMapCacheEntry: private InterpreterOopMap {
 
  private:
   OopMapCacheEntry* _next;
+  uint              _use_count;   // hits since the last eviction in its probe
+                                  // sequence, updated racily by GC threads
 
  protected:
   // Initialization
@@ -59,6 +61,7 @@ class OopMapCacheEntry: private InterpreterOopMap {
  public:
   OopMapCacheEntry() : InterpreterOopMap() {
     _next = NULL;
+    _use_count = 0;
 #ifdef ASSERT
     _resource_allocate_bit_mask = false;
 #endif
@@ -434,8 +437,22 @@ inline unsigned int OopMapCache::hash_value_for(const methodHandle& method, int
 }
 
 OopMapCacheEntry* volatile OopMapCache::_old_entries = NULL;
+volatile uint OopMapCache::_hits = 0;
+volatile uint OopMapCache::_misses = 0;
+volatile uint OopMapCache::_evictions = 0;
+
+int OopMapCache::size_for(int method_count) {
+  // Aim for a load factor of at most 1/2 if every method has one
+  // bci on the stack.
+  int size = _min_size;
+  while (size < 2 * method_count && size < _max_size) {
+    size <<= 1;
+  }
+  return size;
+}
 
-OopMapCache::OopMapCache() {
+OopMapCache::OopMapCache(int size) : _size(size) {
+  assert(is_power_of_2(size) && size >= _min_size && size <= _max_size, "bad size %d", size);
   _array  = NEW_C_HEAP_ARRAY(OopMapCacheEntry*, _size, mtClass);
   for(int i = 0; i < _size; i++) _array[i] = NULL;
 }
@@ -450,11 +467,11 @@ OopMapCache::~OopMapCache() {
 }
 
 OopMapCacheEntry* OopMapCache::entry_at(int i) const {
-  return OrderAccess::load_acquire(&(_array[i % _size]));
+  return OrderAccess::load_acquire(&(_array[i & (_size - 1)]));
 }
 
 bool OopMapCache::put_at(int i, OopMapCacheEntry* entry, OopMapCacheEntry* old) {
-  return Atomic::cmpxchg(entry, &_array[i % _size], old) == old;
+  return Atomic::cmpxchg(entry, &_array[i & (_size - 1)], old) == old;
 }
 
 void OopMapCache::flush() {
@@ -497,6 +514,7 @@ void OopMapCache::lookup(const methodHandle& method,
   int probe = hash_value_for(method, bci);
   int i;
   OopMapCacheEntry* entry = NULL;
+  bool stats = log_is_enabled(Info, interpreter, oopmap);
 
   if (log_is_enabled(Debug, interpreter, oopmap)) {
     static int count = 0;
@@ -510,6 +528,10 @@ void OopMapCache::lookup(const methodHandle& method,
   for(i = 0; i < _probe_depth; i++) {
     entry = entry_at(probe + i);
     if (entry != NULL && !entry->is_empty() && entry->match(method, bci)) {
+      entry->_use_count++;
+      if (stats) {
+        Atomic::inc(&_hits);
+      }
       entry_for->resource_copy(entry);
       assert(!entry_for->is_empty(), "A non-empty oop map should be returned");
       log_debug(interpreter, oopmap)("- found at hash %d", probe + i);
@@ -519,9 +541,13 @@ void OopMapCache::lookup(const methodHandle& method,
 
   // Entry is not in hashtable.
   // Compute entry
+  if (stats) {
+    Atomic::inc(&_misses);
+  }
 
   OopMapCacheEntry* tmp = NEW_C_HEAP_OBJ(OopMapCacheEntry, mtClass);
   tmp->initialize();
+  tmp->_use_count = 0;
   tmp->fill(method, bci);
   entry_for->resource_copy(tmp);
 
@@ -546,12 +572,34 @@ void OopMapCache::lookup(const methodHandle& method,
   }
 
   log_debug(interpreter, oopmap)("*** collision in oopmap cache - flushing item ***");
+  if (stats) {
+    Atomic::inc(&_evictions);
+  }
 
-  // No empty slot (uncommon case). Use (some approximation of a) LRU algorithm
-  // where the first entry in the collision array is replaced with the new one.
-  OopMapCacheEntry* old = entry_at(probe + 0);
-  if (put_at(probe + 0, tmp, old)) {
-    enqueue_for_cleanup(old);
+  // No empty slot (uncommon case). Replace the least used entry of the
+  // collision array and halve the use counts of the others so entries
+  // that used to be hot eventually make room for new ones.
+  int victim = 0;
+  uint victim_uses = max_juint;
+  for (i = 0; i < _probe_depth; i++) {
+    entry = entry_at(probe + i);
+    uint uses = (entry == NULL) ? 0 : entry->_use_count;
+    if (uses < victim_uses) {
+      victim = i;
+      victim_uses = uses;
+    }
+  }
+  for (i = 0; i < _probe_depth; i++) {
+    entry = entry_at(probe + i);
+    if (i != victim && entry != NULL) {
+      entry->_use_count >>= 1;
+    }
+  }
+  OopMapCacheEntry* old = entry_at(probe + victim);
+  if (put_at(probe + victim, tmp, old)) {
+    if (old != NULL) {
+      enqueue_for_cleanup(old);
+    }
   } else {
     enqueue_for_cleanup(tmp);
   }
@@ -579,6 +627,15 @@ void OopMapCache::enqueue_for_cleanup(OopMapCacheEntry* entry) {
 // This is called after GC threads are done and nothing is accessing the old_entries
 // list, so no synchronization needed.
 void OopMapCache::cleanup_old_entries() {
+  uint lookups = _hits + _misses;
+  if (lookups > 0) {
+    log_info(interpreter, oopmap)("OopMapCache: %u lookups, %u hits (%3.1f%%), %u misses, %u evictions",
+                                  lookups, _hits, _hits * 100.0 / lookups, _misses, _evictions);
+    _hits = 0;
+    _misses = 0;
+    _evictions = 0;
+  }
+
   OopMapCacheEntry* entry = _old_entries;
   _old_entries = NULL;
   while (entry != NULL) {
@@ -145,11 +145,20 @@ class InterpreterOopMap: ResourceObj {
 
 class OopMapCache : public CHeapObj<mtClass> {
  static OopMapCacheEntry* volatile _old_entries;
+
+ // Lookup statistics since the last GC, only gathered with
+ // -Xlog:interpreter+oopmap=info
+ static volatile uint _hits;
+ static volatile uint _misses;
+ static volatile uint _evictions;
+
  private:
-  enum { _size        = 32,     // Use fixed size for now
+  enum { _min_size    = 32,     // size for classes with few methods
+         _max_size    = 512,    // size for classes with many methods
          _probe_depth = 3       // probe depth in case of collisions
   };
 
+  const int _size;              // power of two between _min_size and _max_size
   OopMapCacheEntry* volatile * _array;
 
   unsigned int hash_value_for(const methodHandle& method, int bci) const;
@@ -161,7 +170,10 @@ class OopMapCache : public CHeapObj<mtClass> {
   void flush();
 
  public:
-  OopMapCache();
+  // The size of the cache for a class with method_count methods
+  static int size_for(int method_count);
+
+  OopMapCache(int size);
   ~OopMapCache();                                // free up memory
 
   // flush cache entry is occupied by an obsolete method
@@ -118,7 +118,7 @@ void BFSClosure::closure_impl(const oop* reference, const oop pointee) {
   assert(reference != NULL, "invariant");
   assert(UnifiedOop::dereference(reference) == pointee, "invariant");
 
-  if (GranularTimer::is_finished()) {
+  if (GranularTimer::is_finished() || _edge_store->has_all_chains()) {
      return;
   }
 
@@ -157,7 +157,7 @@ void BFSClosure::dfs_fallback() {
   assert(_edge_queue->is_full(), "invariant");
   _use_dfs = true;
   _dfs_fallback_idx = _edge_queue->bottom();
-  while (!_edge_queue->is_empty()) {
+  while (!_edge_queue->is_empty() && !_edge_store->has_all_chains()) {
     const Edge* edge = _edge_queue->remove();
     if (edge->pointee() != NULL) {
       DFSClosure::find_leaks_from_edge(_edge_store, _mark_bits, edge);
@@ -172,6 +172,11 @@ void BFSClosure::process_queue() {
 
   _next_frontier_idx = _edge_queue->top();
   while (!is_complete()) {
+    if (_edge_store->has_all_chains()) {
+      // No need to look at the rest of the heap
+      log_trace(jfr, system)("BFS front: " SIZE_FORMAT " found all sample objects", _current_frontier_level);
+      return;
+    }
     iterate(_edge_queue->remove()); // edge_queue.remove() increments bottom
   }
 }
@@ -72,6 +72,8 @@ class EdgeStore : public CHeapObj<mtTracing> {
  private:
   static traceid _edge_id_counter;
   EdgeHashTable* _edges;
+  size_t _nof_samples;  // sample objects to find chains for
+  size_t _nof_chains;   // sample objects a chain was found for
 
   // Hash table callbacks
   void on_link(EdgeEntry* entry);
@@ -103,6 +105,12 @@ class EdgeStore : public CHeapObj<mtTracing> {
   bool is_empty() const;
   traceid get_id(const Edge* edge) const;
   void put_chain(const Edge* chain, size_t length);
+
+  // The search for reference chains is done once
+  // every marked sample object has been reached
+  void set_nof_samples(size_t nof_samples) { _nof_samples = nof_samples; }
+  size_t nof_chains() const { return _nof_chains; }
+  bool has_all_chains() const { return _nof_samples > 0 && _nof_chains >= _nof_samples; }
 };
 
 #endif // SHARE_VM_LEAKPROFILER_CHAINS_EDGESTORE_HPP
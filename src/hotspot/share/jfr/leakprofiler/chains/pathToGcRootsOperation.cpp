@@ -101,10 +101,13 @@ void PathToGcRootsOperation::doit() {
   // Save the original markWord for the potential leak objects,
   // to be restored on function exit
   ObjectSampleMarker marker;
-  if (ObjectSampleCheckpoint::save_mark_words(_sampler, marker, _emit_all) == 0) {
+  const int nof_samples = ObjectSampleCheckpoint::save_mark_words(_sampler, marker, _emit_all);
+  if (nof_samples == 0) {
     // no valid samples to process
     return;
   }
+  // Stop searching as soon as every sample object has a chain
+  _edge_store->set_nof_samples((size_t)nof_samples);
 
   // Necessary condition for attempting a root set iteration
   Universe::heap()->ensure_parsability(false);
@@ -124,6 +127,9 @@ void PathToGcRootsOperation::doit() {
   }
   GranularTimer::stop();
   log_edge_queue_summary(edge_queue);
+  log_debug(jfr, system)("Found reference chains for " SIZE_FORMAT " of %d sample objects in " UINT64_FORMAT " ms",
+                         _edge_store->nof_chains(), nof_samples,
+                         (GranularTimer::end_time() - GranularTimer::start_time()).milliseconds());
 
   // Emit old objects including their reference chains as events
   EventEmitter emitter(GranularTimer::start_time(), GranularTimer::end_time());
@@ -408,8 +408,9 @@ TRACE_REQUEST_FUNC(ThreadAllocationStatistics) {
   GrowableArray<traceid> thread_ids(initial_size);
   JfrTicks time_stamp = JfrTicks::now();
   {
-    // Collect allocation statistics while holding threads lock
-    MutexLockerEx ml(Threads_lock);
+    // Collect allocation statistics. The ThreadsListHandle keeps the
+    // threads alive, so there is no need to block thread creation and
+    // exit with the Threads_lock while we go through all of them.
     for (JavaThreadIteratorWithHandle jtiwh; JavaThread *jt = jtiwh.next(); ) {
       allocated.append(jt->cooked_allocated_bytes());
       thread_ids.append(JFR_THREAD_ID(jt));
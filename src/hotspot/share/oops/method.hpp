@@ -90,7 +90,8 @@ class Method : public Metadata {
     _has_injected_profile  = 1 << 4,
     _running_emcp          = 1 << 5,
     _intrinsic_candidate   = 1 << 6,
-    _reserved_stack_access = 1 << 7
+    _reserved_stack_access = 1 << 7,
+    _trivial_native        = 1 << 8
   };
   mutable u2 _flags;
 
@@ -765,6 +766,17 @@ class Method : public Metadata {
   bool is_deleted() const                           { return access_flags().is_deleted(); }
   void set_is_deleted()                             { _access_flags.set_is_deleted(); }
 
+  // The current version of an old (redefined) method. Old methods keep
+  // the_class as their holder, so the replacement is found by idnum.
+  Method* get_new_method() const {
+    InstanceKlass* holder = method_holder();
+    Method* new_method = holder->method_with_idnum(orig_method_idnum());
+
+    assert(new_method != NULL, "method_with_idnum() should not be NULL");
+    assert(this != new_method, "sanity check");
+    return new_method;
+  }
+
   bool is_running_emcp() const {
     // EMCP methods are old but not obsolete or deleted. Equivalent
     // Modulo Constant Pool means the method is equivalent except
@@ -895,6 +907,14 @@ class Method : public Metadata {
     _flags = x ? (_flags | _reserved_stack_access) : (_flags & ~_reserved_stack_access);
   }
 
+  // The critical entry point of this native is a JavaTrivial_ one
+  bool is_trivial_native() {
+    return (_flags & _trivial_native) != 0;
+  }
+  void set_trivial_native(bool x) {
+    _flags = x ? (_flags | _trivial_native) : (_flags & ~_trivial_native);
+  }
+
   JFR_ONLY(DEFINE_TRACE_FLAG_ACCESSOR;)
 
   ConstMethod::MethodType method_type() const {
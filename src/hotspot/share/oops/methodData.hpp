@@ -2003,19 +2003,29 @@ public:
       // JVMCI separates trap history for OSR compilations from normal compilations
       u1 _array[JVMCI_ONLY(2 *) MethodData::_trap_hist_limit];
     } _trap_hist;
+    union {
+      intptr_t _align;
+      // Recompilations caused by traps, per reason, saturating
+      u1 _array[MethodData::_trap_hist_limit];
+    } _recompile_hist;
+    jlong _recompile_window_start;    // millis, start of the _recompile_hist window
+    jlong _deopt_storm_end;           // millis, end of the current deoptimization storm
 
     void init_trap_hist() {
       STATIC_ASSERT(sizeof(_trap_hist) % HeapWordSize == 0); // "align"
       uint size_in_words = sizeof(_trap_hist) / HeapWordSize;
       Copy::zero_to_words((HeapWord*) &_trap_hist, size_in_words);
+      Copy::zero_to_words((HeapWord*) &_recompile_hist, sizeof(_recompile_hist) / HeapWordSize);
     }
   public:
     CompilerCounters(Method* m) : _creation_mileage(MethodData::mileage_of(m)),
-      _nof_decompiles(0), _nof_overflow_recompiles(0), _nof_overflow_traps(0) {
+      _nof_decompiles(0), _nof_overflow_recompiles(0), _nof_overflow_traps(0),
+      _recompile_window_start(0), _deopt_storm_end(0) {
       init_trap_hist();
     }
     CompilerCounters() : _creation_mileage(0), // for ciMethodData
-      _nof_decompiles(0), _nof_overflow_recompiles(0), _nof_overflow_traps(0) {
+      _nof_decompiles(0), _nof_overflow_recompiles(0), _nof_overflow_traps(0),
+      _recompile_window_start(0), _deopt_storm_end(0) {
       init_trap_hist();
     }
 
@@ -2055,6 +2065,27 @@ public:
     uint inc_decompile_count() {
       return ++_nof_decompiles;
     }
+    uint reason_recompile_count(int reason) const {
+      assert((uint)reason < ARRAY_SIZE(_recompile_hist._array), "oob");
+      return _recompile_hist._array[reason];
+    }
+    // Counts restart for all reasons once window_millis have passed since
+    // the first recompilation of the current window.
+    uint inc_reason_recompile_count(int reason, jlong now_millis, jlong window_millis) {
+      assert((uint)reason < ARRAY_SIZE(_recompile_hist._array), "oob");
+      if (_recompile_window_start == 0 || now_millis - _recompile_window_start > window_millis) {
+        Copy::zero_to_words((HeapWord*) &_recompile_hist, sizeof(_recompile_hist) / HeapWordSize);
+        _recompile_window_start = now_millis;
+      }
+      uint cnt = _recompile_hist._array[reason];
+      if (cnt < max_jubyte) {
+        _recompile_hist._array[reason] = ++cnt;
+      }
+      return cnt;
+    }
+
+    void set_deopt_storm_end(jlong end_millis) { _deopt_storm_end = end_millis; }
+    bool in_deopt_storm(jlong now_millis) const { return now_millis < _deopt_storm_end; }
 
     // Support for code generation
     static ByteSize trap_history_offset() {
@@ -2411,6 +2442,22 @@ public:
     }
     return dec_count;
   }
+  // Number of times a trap with the given reason caused a recompilation
+  // of this method within the current window, saturating at max_jubyte.
+  uint reason_recompile_count(int reason) const {
+    return _compiler_counters.reason_recompile_count(reason);
+  }
+  uint inc_reason_recompile_count(int reason, jlong now_millis, jlong window_millis) {
+    return _compiler_counters.inc_reason_recompile_count(reason, now_millis, window_millis);
+  }
+  // While in a deoptimization storm the method is not compiled at the
+  // highest tier.
+  void set_deopt_storm_end(jlong end_millis) {
+    _compiler_counters.set_deopt_storm_end(end_millis);
+  }
+  bool in_deopt_storm(jlong now_millis) const {
+    return _compiler_counters.in_deopt_storm(now_millis);
+  }
   uint tenure_traps() const {
     return _tenure_traps;
   }
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "jvm.h"
 #include "ci/ciReplay.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
@@ -32,6 +33,7 @@
 #include "jfr/jfrEvents.hpp"
 #include "oops/objArrayKlass.hpp"
 #include "opto/callGenerator.hpp"
+#include "opto/callnode.hpp"
 #include "opto/parse.hpp"
 #include "runtime/handles.inline.hpp"
 #include "utilities/events.hpp"
@@ -111,10 +113,42 @@ static bool is_unboxing_method(ciMethod* callee_method, Compile* C) {
   return C->eliminate_boxing() && callee_method->is_unboxing_method();
 }
 
+/**
+ *  Estimate what inlining the callee at this call site would buy beyond
+ *  saving the call: each constant argument is likely to fold in the
+ *  callee and each argument allocated in this compilation may become
+ *  non-escaping once the callee is inlined.
+ */
+int InlineTree::inline_benefit(ciMethod* callee_method, JVMState* jvms) const {
+  SafePointNode* map = jvms->map();
+  if (!UseInlineBenefitEstimate || map == NULL) {
+    return 0;
+  }
+  PhaseGVN* gvn = C->initial_gvn();
+  int benefit = 0;
+  for (int i = 0; i < callee_method->arg_size(); i++) {
+    Node* arg = map->argument(jvms, i);
+    if (arg == NULL || arg->is_top()) {
+      continue;
+    }
+    arg = arg->uncast();
+    if (gvn->type(arg)->singleton()) {
+      benefit++;
+    } else if (C->do_escape_analysis() && EliminateAllocations &&
+               AllocateNode::Ideal_allocation(arg, gvn) != NULL) {
+      benefit += 2;
+    }
+  }
+  return benefit;
+}
+
 // positive filter: should callee be inlined?
 bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
                                int caller_bci, ciCallProfile& profile,
+                               int benefit, bool& fits_by_benefit,
                                WarmCallInfo* wci_result) {
+  fits_by_benefit = false;
+
   // Allows targeted inlining
   if (C->directive()->should_inline(callee_method)) {
     *wci_result = *(WarmCallInfo::always_hot());
@@ -173,6 +207,20 @@ bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
       is_init_with_ea(callee_method, caller_method, C)) {
 
     max_inline_size = C->freq_inline_size();
+    if (benefit > 0 && size > max_inline_size) {
+      // Hot call sites that are likely to simplify once inlined get a
+      // larger size limit, paid for from the DesiredMethodLimit budget
+      // of the whole compilation.
+      int budget = DesiredMethodLimit - (int)C->ilt()->count_inline_bcs();
+      int benefit_size = MIN2(max_inline_size + benefit * default_max_inline_size, budget);
+      max_inline_size = MAX2(max_inline_size, benefit_size);
+      if (size <= max_inline_size) {
+        fits_by_benefit = true;
+        char* buf = NEW_ARENA_ARRAY(C->comp_arena(), char, 64);
+        jio_snprintf(buf, 64, "inline (hot, freq %d, benefit %d)", freq, benefit);
+        set_msg(buf);
+      }
+    }
     if (size <= max_inline_size && TraceFrequencyInlining) {
       CompileTask::print_inline_indent(inline_level());
       tty->print_cr("Inlined frequent method (freq=%d count=%d):", freq, call_site_count);
@@ -204,6 +252,7 @@ bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
 bool InlineTree::should_not_inline(ciMethod *callee_method,
                                    ciMethod* caller_method,
                                    JVMState* jvms,
+                                   bool fits_by_benefit,
                                    WarmCallInfo* wci_result) {
 
   const char* fail_msg = NULL;
@@ -273,8 +322,12 @@ bool InlineTree::should_not_inline(ciMethod *callee_method,
     return false;
   }
 
+  // The size of the callee's nmethod says more about what was inlined
+  // into it than about the callee itself: don't hold it against hot call
+  // sites that only fit the size limit because of their benefit.
   if (callee_method->has_compiled_code() &&
-      callee_method->instructions_size() > InlineSmallCode) {
+      callee_method->instructions_size() > InlineSmallCode &&
+      !fits_by_benefit) {
     set_msg("already compiled into a big method");
     return true;
   }
@@ -345,11 +398,13 @@ bool InlineTree::try_to_inline(ciMethod* callee_method, ciMethod* caller_method,
   }
 
   _forced_inline = false; // Reset
+  int benefit = inline_benefit(callee_method, jvms);
+  bool fits_by_benefit = false;
   if (!should_inline(callee_method, caller_method, caller_bci, profile,
-                     wci_result)) {
+                     benefit, fits_by_benefit, wci_result)) {
     return false;
   }
-  if (should_not_inline(callee_method, caller_method, jvms, wci_result)) {
+  if (should_not_inline(callee_method, caller_method, jvms, fits_by_benefit, wci_result)) {
     return false;
   }
 
@@ -219,6 +219,14 @@
   product(bool, UseCountedLoopSafepoints, false,                            \
           "Force counted loops to keep a safepoint")                        \
                                                                             \
+  product(bool, UseLongCountedLoopNest, true,                               \
+          "Transform loops with a long induction variable into a nest "     \
+          "with an int counted inner loop")                                 \
+                                                                            \
+  diagnostic(bool, UseInlineBenefitEstimate, false,                         \
+          "Raise the inlining size limit of hot call sites with constant "  \
+          "or freshly allocated arguments")                                 \
+                                                                            \
   product(bool, UseLoopPredicate, true,                                     \
           "Generate a predicate to select fast/slow loop versions")         \
                                                                             \
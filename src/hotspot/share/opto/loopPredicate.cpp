@@ -603,27 +603,26 @@ class Invariance : public StackObj {
   }
 };
 
-//------------------------------is_range_check_if -----------------------------------
-// Returns true if the predicate of iff is in "scale*iv + offset u< load_range(ptr)" format
-// Note: this function is particularly designed for loop predication. We require load_range
-//       and offset to be loop invariant computed on the fly by "invar"
-bool IdealLoopTree::is_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar DEBUG_ONLY(COMMA ProjNode *predicate_proj)) const {
+//------------------------------range_check_cmp -------------------------------------
+// Returns the "index u< range" compare of iff if iff is a loop exit in
+// that format and range is loop invariant, NULL otherwise.
+const CmpNode* IdealLoopTree::range_check_cmp(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar) const {
   if (!is_loop_exit(iff)) {
-    return false;
+    return NULL;
   }
   if (!iff->in(1)->is_Bool()) {
-    return false;
+    return NULL;
   }
   const BoolNode *bol = iff->in(1)->as_Bool();
   if (bol->_test._test != BoolTest::lt) {
-    return false;
+    return NULL;
   }
   if (!bol->in(1)->is_Cmp()) {
-    return false;
+    return NULL;
   }
   const CmpNode *cmp = bol->in(1)->as_Cmp();
   if (cmp->Opcode() != Op_CmpU) {
-    return false;
+    return NULL;
   }
   Node* range = cmp->in(2);
   if (range->Opcode() != Op_LoadRange && !iff->is_RangeCheck()) {
@@ -633,10 +632,22 @@ bool IdealLoopTree::is_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invari
       // This allows optimization of loops where the length of the
       // array is a known value and doesn't need to be loaded back
       // from the array.
-      return false;
+      return NULL;
     }
   }
   if (!invar.is_invariant(range)) {
+    return NULL;
+  }
+  return cmp;
+}
+
+//------------------------------is_range_check_if -----------------------------------
+// Returns true if the predicate of iff is in "scale*iv + offset u< load_range(ptr)" format
+// Note: this function is particularly designed for loop predication. We require load_range
+//       and offset to be loop invariant computed on the fly by "invar"
+bool IdealLoopTree::is_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar DEBUG_ONLY(COMMA ProjNode *predicate_proj)) const {
+  const CmpNode *cmp = range_check_cmp(iff, phase, invar);
+  if (cmp == NULL) {
     return false;
   }
 
@@ -680,6 +691,69 @@ bool IdealLoopTree::is_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invari
   return true;
 }
 
+//------------------------------is_masked_range_check_if----------------------------
+// Returns true if the predicate of iff is in "x & mask u< range" format
+// with mask and range loop invariant. x can be anything: "x & mask" is
+// never above mask when compared unsigned so "mask u< range" is a
+// predicate for the whole loop. This is how hash tables and ring
+// buffers are indexed.
+bool IdealLoopTree::is_masked_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar, Node*& mask) const {
+  const CmpNode *cmp = range_check_cmp(iff, phase, invar);
+  if (cmp == NULL) {
+    return false;
+  }
+  Node* idx = cmp->in(1);
+  if (idx->Opcode() != Op_AndI) {
+    return false;
+  }
+  if (invar.is_invariant(idx->in(2))) {
+    mask = idx->in(2);
+  } else if (invar.is_invariant(idx->in(1))) {
+    mask = idx->in(1);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+//------------------------------is_invariant_scaled_range_check_if------------------
+// Returns true if the predicate of iff is in "iv*scale + offset u< range"
+// format where scale is loop invariant but not a constant (a stride
+// loaded from a field for instance) and offset and range are loop
+// invariant. Constant scales are handled by is_range_check_if().
+bool IdealLoopTree::is_invariant_scaled_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar,
+                                                       Node*& scale, Node*& offset) const {
+  const CmpNode *cmp = range_check_cmp(iff, phase, invar);
+  if (cmp == NULL) {
+    return false;
+  }
+  Node* iv = _head->as_CountedLoop()->phi();
+  Node* mul = cmp->in(1);
+  offset = NULL;
+  if (mul->Opcode() == Op_AddI) {
+    if (invar.is_invariant(mul->in(2))) {
+      offset = mul->in(2);
+      mul = mul->in(1);
+    } else if (invar.is_invariant(mul->in(1))) {
+      offset = mul->in(1);
+      mul = mul->in(2);
+    } else {
+      return false;
+    }
+  }
+  if (mul->Opcode() != Op_MulI) {
+    return false;
+  }
+  if (mul->in(1) == iv && invar.is_invariant(mul->in(2))) {
+    scale = mul->in(2);
+  } else if (mul->in(2) == iv && invar.is_invariant(mul->in(1))) {
+    scale = mul->in(1);
+  } else {
+    return false;
+  }
+  return !scale->is_Con();
+}
+
 //------------------------------rc_predicate-----------------------------------
 // Create a range check predicate
 //
@@ -835,6 +909,31 @@ BoolNode* PhaseIdealLoop::rc_predicate(IdealLoopTree *loop, Node* ctrl,
   return bol;
 }
 
+//------------------------------rc_predicate_long------------------------------
+// Create a range check predicate "scale*value + offset u< range" for
+// an index with a non constant scale. The expression is computed with
+// longs from int inputs so it can't overflow. value is a long.
+BoolNode* PhaseIdealLoop::rc_predicate_long(Node* ctrl, Node* scale, Node* offset, Node* value,
+                                            Node* range, bool negate) {
+  Node* scale_l = new ConvI2LNode(scale);
+  register_new_node(scale_l, ctrl);
+  Node* idx = new MulLNode(value, scale_l);
+  register_new_node(idx, ctrl);
+  if (offset != NULL) {
+    Node* offset_l = new ConvI2LNode(offset);
+    register_new_node(offset_l, ctrl);
+    idx = new AddLNode(idx, offset_l);
+    register_new_node(idx, ctrl);
+  }
+  Node* range_l = new ConvI2LNode(range);
+  register_new_node(range_l, ctrl);
+  CmpNode* cmp = new CmpULNode(idx, range_l);
+  register_new_node(cmp, ctrl);
+  BoolNode* bol = new BoolNode(cmp, negate ? BoolTest::ge : BoolTest::lt);
+  register_new_node(bol, ctrl);
+  return bol;
+}
+
 // Should loop predication look not only in the path from tail to head
 // but also in branches of the loop body?
 bool PhaseIdealLoop::loop_predication_should_follow_branches(IdealLoopTree *loop, ProjNode *predicate_proj, float& loop_trip_cnt) {
@@ -1123,6 +1222,9 @@ bool PhaseIdealLoop::loop_predication_impl_helper(IdealLoopTree *loop, ProjNode*
                                                   Deoptimization::DeoptReason reason) {
   // Following are changed to nonnull when a predicate can be hoisted
   ProjNode* new_predicate_proj = NULL;
+  Node* mask = NULL;
+  Node* scale_n = NULL;
+  Node* offset_n = NULL;
   IfNode*   iff  = proj->in(0)->as_If();
   Node*     test = iff->in(1);
   if (!test->is_Bool()){ //Conv2B, ...
@@ -1225,6 +1327,80 @@ bool PhaseIdealLoop::loop_predication_impl_helper(IdealLoopTree *loop, ProjNode*
       tty->print("Predicate RC ");
       loop->dump_head();
     }
+#endif
+  } else if (loop->is_masked_range_check_if(iff, this, invar, mask)) {
+    // Range check of a masked index: "mask u< range" implies the check
+    // for every iteration.
+    const Node* cmp = bol->in(1)->as_Cmp();
+    new_predicate_proj = create_new_if_for_predicate(predicate_proj, NULL,
+                                                     reason,
+                                                     iff->Opcode());
+    Node* ctrl = new_predicate_proj->in(0)->as_If()->in(0);
+    Node* rng = invar.clone(cmp->in(2), ctrl);
+    mask = invar.clone(mask, ctrl);
+    Node* mask_cmp = new CmpUNode(mask, rng);
+    register_new_node(mask_cmp, ctrl);
+    bool negate = (proj->_con != predicate_proj->_con);
+    BoolNode* mask_bol = new BoolNode(mask_cmp, negate ? BoolTest::ge : BoolTest::lt);
+    register_new_node(mask_bol, ctrl);
+    IfNode* new_predicate_iff = new_predicate_proj->in(0)->as_If();
+    _igvn.hash_delete(new_predicate_iff);
+    new_predicate_iff->set_req(1, mask_bol);
+#ifndef PRODUCT
+    if (TraceLoopPredicate) {
+      tty->print("Predicate masked range check if: %d ", new_predicate_iff->_idx);
+      loop->dump_head();
+    } else if (TraceLoopOpts) {
+      tty->print("Predicate RC mask ");
+      loop->dump_head();
+    }
+#endif
+  } else if (cl != NULL && loop->is_invariant_scaled_range_check_if(iff, this, invar, scale_n, offset_n)) {
+    // Range check with a loop invariant scale of unknown sign: the
+    // index is within bounds for all iterations if it is within bounds
+    // for the first and last ones.
+    const Node* cmp = bol->in(1)->as_Cmp();
+    Node* init  = cl->init_trip();
+    Node* limit = exact_limit(loop);
+    int stride  = cl->stride()->get_int();
+    bool negate = (proj->_con != predicate_proj->_con);
+
+    ProjNode* first_proj = create_new_if_for_predicate(predicate_proj, NULL, reason, Op_If);
+    Node* ctrl = first_proj->in(0)->as_If()->in(0);
+    Node* rng = invar.clone(cmp->in(2), ctrl);
+    scale_n = invar.clone(scale_n, ctrl);
+    if (offset_n != NULL) {
+      offset_n = invar.clone(offset_n, ctrl);
+    }
+    Node* first = new ConvI2LNode(init);
+    register_new_node(first, ctrl);
+    BoolNode* first_bol = rc_predicate_long(ctrl, scale_n, offset_n, first, rng, negate);
+    IfNode* first_iff = first_proj->in(0)->as_If();
+    _igvn.hash_delete(first_iff);
+    first_iff->set_req(1, first_bol);
+
+    ProjNode* last_proj = create_new_if_for_predicate(predicate_proj, NULL, reason, Op_If);
+    assert(last_proj->in(0)->as_If()->in(0) == first_proj, "should dominate");
+    Node* last = new ConvI2LNode(limit);
+    register_new_node(last, first_proj);
+    ConLNode* con_stride = _igvn.longcon(stride);
+    set_ctrl(con_stride, C->root());
+    last = new SubLNode(last, con_stride);
+    register_new_node(last, first_proj);
+    BoolNode* last_bol = rc_predicate_long(first_proj, scale_n, offset_n, last, rng, negate);
+    IfNode* last_iff = last_proj->in(0)->as_If();
+    _igvn.hash_delete(last_iff);
+    last_iff->set_req(1, last_bol);
+
+    new_predicate_proj = last_proj;
+#ifndef PRODUCT
+    if (TraceLoopPredicate) {
+      tty->print("Predicate invariant scale range check if: %d %d ", first_iff->_idx, last_iff->_idx);
+      loop->dump_head();
+    } else if (TraceLoopOpts) {
+      tty->print("Predicate RC scale ");
+      loop->dump_head();
+    }
 #endif
   } else {
     // Loop variant check (for example, range check in non-counted loop)
@@ -32,11 +32,13 @@
 #include "memory/resourceArea.hpp"
 #include "opto/addnode.hpp"
 #include "opto/callnode.hpp"
+#include "opto/castnode.hpp"
 #include "opto/connode.hpp"
 #include "opto/convertnode.hpp"
 #include "opto/divnode.hpp"
 #include "opto/idealGraphPrinter.hpp"
 #include "opto/loopnode.hpp"
+#include "opto/movenode.hpp"
 #include "opto/mulnode.hpp"
 #include "opto/rootnode.hpp"
 #include "opto/superword.hpp"
@@ -900,6 +902,256 @@ bool PhaseIdealLoop::is_counted_loop(Node* x, IdealLoopTree*& loop) {
   return true;
 }
 
+//------------------------------is_long_counted_loop---------------------------
+// A loop with a long induction variable is never a CountedLoop so none
+// of range check elimination, unrolling, vectorization or strip mining
+// apply to it. Transform it into a nest of two loops:
+//
+// for (long i = init; i < limit; i += stride) { ... }
+//
+// becomes
+//
+// for (long i = init; i < limit; i = i + j) {
+//   int inner_limit = (int)min_unsigned(max(limit - i, 0), max_jint - |stride|);
+//   for (int j = 0; j < inner_limit; j += stride) {
+//     ... (uses of the long iv become i + (long)j)
+//   }
+// }
+//
+// The inner loop only needs an int induction variable and is
+// recognized as a CountedLoop on the next round of loop
+// optimizations. The outer loop is not counted: it runs once per
+// max_jint iterations of the inner loop and carries a copy of the
+// loop's safepoint so time to safepoint is not affected when the inner
+// loop loses its own.
+bool PhaseIdealLoop::is_long_counted_loop(Node* x, IdealLoopTree*& loop) {
+  if (!UseLongCountedLoopNest || x->Opcode() != Op_Loop || x->req() != 3 ||
+      loop->_irreducible || loop->_child != NULL) {
+    return false;
+  }
+  Node* init_control = x->in(LoopNode::EntryControl);
+  Node* back_control = x->in(LoopNode::LoopBackControl);
+  if (init_control == NULL || back_control == NULL ||
+      init_control->is_top() || back_control->is_top()) {
+    return false;
+  }
+
+  // Controlling test for loop
+  uint iftrue_op = back_control->Opcode();
+  if (iftrue_op != Op_IfTrue && iftrue_op != Op_IfFalse) {
+    return false;
+  }
+  IfNode* iff = back_control->in(0)->as_If();
+  if (get_loop(iff) != loop || !iff->in(1)->is_Bool()) {
+    return false;
+  }
+  // The safepoint immediately preceding the exit test is cloned on
+  // the outer loop backedge where it has the same jvm state.
+  Node* sfpt = iff->in(0);
+  if (sfpt->Opcode() != Op_SafePoint || get_loop(sfpt) != loop) {
+    return false;
+  }
+  BoolNode* test = iff->in(1)->as_Bool();
+  BoolTest::mask bt = test->_test._test;
+  if (iftrue_op == Op_IfFalse) {
+    bt = BoolTest(bt).negate();
+  }
+  Node* cmp = test->in(1);
+  if (cmp->Opcode() != Op_CmpL) {
+    return false;
+  }
+  Node* incr = cmp->in(1);
+  Node* limit = cmp->in(2);
+  if (!is_member(loop, get_ctrl(incr))) {
+    Node* tmp = incr;
+    incr = limit;
+    limit = tmp;
+    bt = BoolTest(bt).commute();
+  }
+  if (is_member(loop, get_ctrl(limit)) || incr->Opcode() != Op_AddL) {
+    return false;
+  }
+  Node* xphi = incr->in(1);
+  Node* stride = incr->in(2);
+  if (!stride->is_Con()) {
+    xphi = stride;
+    stride = incr->in(1);
+    if (!stride->is_Con()) {
+      return false;
+    }
+  }
+  if (!xphi->is_Phi() || xphi->in(0) != x ||
+      xphi->in(LoopNode::LoopBackControl) != incr) {
+    return false;
+  }
+  PhiNode* phi = xphi->as_Phi();
+
+  // The stride must fit in an int with room left for iterations of
+  // the inner loop.
+  jlong stride_con = stride->get_long();
+  if (stride_con == 0 || stride_con >= max_jint / 2 || stride_con <= -(max_jint / 2)) {
+    return false;
+  }
+  // Only the exit tests for which the inner loop can be given an
+  // exact limit are handled.
+  if ((stride_con > 0 && bt != BoolTest::lt) ||
+      (stride_con < 0 && bt != BoolTest::gt)) {
+    return false;
+  }
+  jlong iters_limit = max_jint - ABS(stride_con);
+
+  // The exit projection of the loop becomes the exit projection of
+  // the outer loop.
+  Node* exit_proj = iff->proj_out(iftrue_op == Op_IfTrue ? 0 : 1);
+  Node* inner_exit = exit_proj->clone();
+
+  float outer_prob = iftrue_op == Op_IfTrue ? PROB_UNLIKELY_MAG(3) : PROB_LIKELY_MAG(3);
+  IfNode* outer_if = new IfNode(inner_exit, test, outer_prob, COUNT_UNKNOWN);
+  Node* outer_cont;
+  if (iftrue_op == Op_IfTrue) {
+    outer_cont = new IfTrueNode(outer_if);
+  } else {
+    outer_cont = new IfFalseNode(outer_if);
+  }
+  Node* outer_sfpt = sfpt->clone();
+  outer_sfpt->set_req(TypeFunc::Control, outer_cont);
+  LoopNode* outer_head = new LoopNode(init_control, outer_sfpt);
+
+  IdealLoopTree* outer_ilt = new IdealLoopTree(this, outer_head, outer_sfpt);
+  IdealLoopTree* parent = loop->_parent;
+  IdealLoopTree* sibling = parent->_child;
+  if (sibling == loop) {
+    parent->_child = outer_ilt;
+  } else {
+    while (sibling->_next != loop) {
+      sibling = sibling->_next;
+    }
+    sibling->_next = outer_ilt;
+  }
+  outer_ilt->_next = loop->_next;
+  outer_ilt->_parent = parent;
+  outer_ilt->_child = loop;
+  outer_ilt->_nest = loop->_nest;
+  loop->_parent = outer_ilt;
+  loop->_next = NULL;
+  loop->_nest++;
+  assert(loop->_nest <= SHRT_MAX, "sanity");
+
+  register_control(inner_exit, outer_ilt, iff);
+  register_control(outer_if, outer_ilt, inner_exit);
+  register_control(outer_cont, outer_ilt, outer_if);
+  register_control(outer_sfpt, outer_ilt, outer_cont);
+  _igvn.register_new_node_with_optimizer(outer_head);
+  set_loop(outer_head, outer_ilt);
+  set_idom(outer_head, init_control, dom_depth(init_control) + 1);
+  _igvn.replace_input_of(exit_proj, 0, outer_if);
+  set_idom(exit_proj, outer_if, dom_depth(outer_if));
+  _igvn.replace_input_of(x, LoopNode::EntryControl, outer_head);
+  set_idom(x, outer_head, dom_depth(outer_head));
+
+  // Every value carried around the loop is also carried around the
+  // outer loop.
+  Node_List phis;
+  for (DUIterator_Fast imax, i = x->fast_outs(imax); i < imax; i++) {
+    Node* u = x->fast_out(i);
+    if (u->is_Phi() && u->in(0) == x) {
+      phis.push(u);
+    }
+  }
+  Node* outer_phi = NULL;
+  for (uint i = 0; i < phis.size(); i++) {
+    Node* p = phis.at(i);
+    Node* op = p->clone();
+    op->set_req(0, outer_head);
+    register_new_node(op, outer_head);
+    _igvn.replace_input_of(p, LoopNode::EntryControl, op);
+    if (p == phi) {
+      outer_phi = op;
+    }
+  }
+  assert(outer_phi != NULL, "iv phi not found");
+
+  // Number of iterations left, in units of the long iv, capped so the
+  // int iv of the inner loop can't overflow.
+  Node* zero_l = _igvn.longcon(0);
+  set_ctrl(zero_l, C->root());
+  Node* iters_limit_l = _igvn.longcon(iters_limit);
+  set_ctrl(iters_limit_l, C->root());
+  Node* left;
+  Node* left_cmp;
+  if (stride_con > 0) {
+    left = new SubLNode(limit, outer_phi);
+    left_cmp = new CmpLNode(limit, outer_phi);
+  } else {
+    left = new SubLNode(outer_phi, limit);
+    left_cmp = new CmpLNode(outer_phi, limit);
+  }
+  register_new_node(left, outer_head);
+  register_new_node(left_cmp, outer_head);
+  Node* left_bol = new BoolNode(left_cmp, BoolTest::gt);
+  register_new_node(left_bol, outer_head);
+  Node* max_left = CMoveNode::make(outer_head, left_bol, zero_l, left, TypeLong::LONG);
+  register_new_node(max_left, outer_head);
+  // limit - i can overflow but is then a large unsigned value
+  Node* cap_cmp = new CmpULNode(max_left, iters_limit_l);
+  register_new_node(cap_cmp, outer_head);
+  Node* cap_bol = new BoolNode(cap_cmp, BoolTest::lt);
+  register_new_node(cap_bol, outer_head);
+  Node* capped = CMoveNode::make(outer_head, cap_bol, iters_limit_l, max_left,
+                                 TypeLong::make(0, iters_limit, Type::WidenMin));
+  register_new_node(capped, outer_head);
+  Node* inner_limit = new ConvL2INode(capped);
+  register_new_node(inner_limit, outer_head);
+  // ConvL2I doesn't narrow its type: is_counted_loop() needs the limit
+  // to be known not to overflow the iv or it would want a limit check
+  // predicate that the inner loop doesn't have.
+  inner_limit = new CastIINode(inner_limit, TypeInt::make(0, (jint)iters_limit, Type::WidenMin));
+  register_new_node(inner_limit, outer_head);
+  Node* zero_i = _igvn.intcon(0);
+  set_ctrl(zero_i, C->root());
+  if (stride_con < 0) {
+    inner_limit = new SubINode(zero_i, inner_limit);
+    register_new_node(inner_limit, outer_head);
+  }
+
+  // New int iv for the inner loop
+  Node* stride_i = _igvn.intcon((jint)stride_con);
+  set_ctrl(stride_i, C->root());
+  PhiNode* inner_phi = new PhiNode(x, TypeInt::INT);
+  Node* inner_incr = new AddINode(inner_phi, stride_i);
+  inner_phi->init_req(LoopNode::EntryControl, zero_i);
+  inner_phi->init_req(LoopNode::LoopBackControl, inner_incr);
+  register_new_node(inner_phi, x);
+  register_new_node(inner_incr, x);
+  Node* inner_cmp = new CmpINode(inner_incr, inner_limit);
+  register_new_node(inner_cmp, x);
+  BoolTest::mask inner_bt = stride_con > 0 ? BoolTest::lt : BoolTest::gt;
+  if (iftrue_op == Op_IfFalse) {
+    inner_bt = BoolTest(inner_bt).negate();
+  }
+  Node* inner_bol = new BoolNode(inner_cmp, inner_bt);
+  register_new_node(inner_bol, x);
+  _igvn.replace_input_of(iff, 1, inner_bol);
+
+  // The long iv is now derived from the outer and inner ivs
+  Node* inner_iv_l = new ConvI2LNode(inner_phi);
+  register_new_node(inner_iv_l, x);
+  Node* iv = new AddLNode(outer_phi, inner_iv_l);
+  register_new_node(iv, x);
+  _igvn.replace_node(phi, iv);
+
+#ifndef PRODUCT
+  if (TraceLoopOpts) {
+    tty->print("LongCounted  ");
+    loop->dump_head();
+  }
+#endif
+
+  C->set_major_progress();
+  loop = outer_ilt;
+  return true;
+}
+
 //----------------------exact_limit-------------------------------------------
 Node* PhaseIdealLoop::exact_limit( IdealLoopTree *loop ) {
   assert(loop->_head->is_CountedLoop(), "");
@@ -2458,6 +2710,10 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
     // Look for induction variables
     phase->replace_parallel_iv(this);
 
+  } else if (phase->is_long_counted_loop(_head, loop)) {
+    // The int inner loop of the new loop nest is turned into a counted
+    // loop on the next round of loop optimizations. Leave safepoints
+    // alone until then.
   } else if (_parent != NULL && !_irreducible) {
     // Not a counted loop. Keep one safepoint.
     bool keep_one_sfpt = true;
@@ -2465,7 +2721,8 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
   }
 
   // Recursively
-  assert(loop->_child != this || (loop->_head->as_Loop()->is_OuterStripMinedLoop() && _head->as_CountedLoop()->is_strip_mined()), "what kind of loop was added?");
+  assert(loop->_child != this || (loop->_head->as_Loop()->is_OuterStripMinedLoop() && _head->as_CountedLoop()->is_strip_mined()) ||
+         (loop->_head->Opcode() == Op_Loop && !_head->is_CountedLoop()), "what kind of loop was added?");
   assert(loop->_child != this || (loop->_child->_child == NULL && loop->_child->_next == NULL), "would miss some loops");
   if (loop->_child && loop->_child != this) loop->_child->counted_loop(phase);
   if (loop->_next)  loop->_next ->counted_loop(phase);
@@ -623,6 +623,13 @@ public:
 
   // Return TRUE if "iff" is a range check.
   bool is_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar DEBUG_ONLY(COMMA ProjNode *predicate_proj)) const;
+  // Return TRUE if "iff" is a range check of a masked index.
+  bool is_masked_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar, Node*& mask) const;
+  // Return TRUE if "iff" is a range check of the iv scaled by a loop invariant.
+  bool is_invariant_scaled_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar,
+                                          Node*& scale, Node*& offset) const;
+  // Return the compare of "iff" if it is a range check with an invariant range.
+  const CmpNode* range_check_cmp(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar) const;
 
   // Estimate the number of nodes required when cloning a loop (body).
   uint est_loop_clone_sz(uint factor) const;
@@ -1038,6 +1045,7 @@ public:
   virtual Node* transform(Node* n) { return 0; }
 
   bool is_counted_loop(Node* n, IdealLoopTree* &loop);
+  bool is_long_counted_loop(Node* n, IdealLoopTree* &loop);
   IdealLoopTree* create_outer_strip_mined_loop(BoolNode *test, Node *cmp, Node *init_control,
                                                IdealLoopTree* loop, float cl_prob, float le_fcnt,
                                                Node*& entry_control, Node*& iffalse);
@@ -1156,6 +1164,8 @@ public:
                          Node* init, Node* limit, jint stride,
                          Node* range, bool upper, bool &overflow,
                          bool negate);
+  BoolNode* rc_predicate_long(Node* ctrl, Node* scale, Node* offset, Node* value,
+                              Node* range, bool negate);
 
   // Implementation of the loop predication to promote checks outside the loop
   bool loop_predication_impl(IdealLoopTree *loop);
@@ -79,14 +79,18 @@ protected:
                             ciCallProfile& profile,
                             WarmCallInfo* wci_result,
                             bool& should_delay);
+  int         inline_benefit(ciMethod* callee_method, JVMState* jvms) const;
   bool        should_inline(ciMethod* callee_method,
                             ciMethod* caller_method,
                             int caller_bci,
                             ciCallProfile& profile,
+                            int benefit,
+                            bool& fits_by_benefit,
                             WarmCallInfo* wci_result);
   bool        should_not_inline(ciMethod* callee_method,
                                 ciMethod* caller_method,
                                 JVMState* jvms,
+                                bool fits_by_benefit,
                                 WarmCallInfo* wci_result);
   void        print_inlining(ciMethod* callee_method, int caller_bci,
                              ciMethod* caller_method, bool success) const;
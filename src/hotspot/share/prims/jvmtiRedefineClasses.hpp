@@ -338,7 +338,7 @@ struct JvmtiCachedClassFileData {
 class VM_RedefineClasses: public VM_Operation {
  private:
   // These static fields are needed by ClassLoaderDataGraph::classes_do()
-  // facility and the AdjustCpoolCacheAndVtable helper:
+  // facility and the helper closures:
   static Array<Method*>* _old_methods;
   static Array<Method*>* _new_methods;
   static Method**      _matching_old_methods;
@@ -349,6 +349,7 @@ class VM_RedefineClasses: public VM_Operation {
   static int             _deleted_methods_length;
   static int             _added_methods_length;
   static Klass*          _the_class;
+  static bool            _has_redefined_Object;
 
   // The instance fields are used to pass information from
   // doit_prologue() to doit() and doit_epilogue().
@@ -509,21 +510,15 @@ class VM_RedefineClasses: public VM_Operation {
     void do_klass(Klass* k);
   };
 
-  // Unevolving classes may point to methods of the_class directly
-  // from their constant pool caches, itables, and/or vtables. We
-  // use the ClassLoaderDataGraph::classes_do() facility and this helper
-  // to fix up these pointers.
-  class AdjustCpoolCacheAndVtable : public KlassClosure {
+  // Unevolving classes may point to methods of the redefined classes
+  // directly from their constant pool caches, itables, and/or vtables,
+  // and MethodData may refer to old methods. We use the
+  // ClassLoaderDataGraph::classes_do() facility and this helper to fix
+  // up these pointers once for all classes redefined by the operation.
+  class AdjustAndCleanMetadata : public KlassClosure {
     Thread* _thread;
    public:
-    AdjustCpoolCacheAndVtable(Thread* t) : _thread(t) {}
-    void do_klass(Klass* k);
-  };
-
-  // Clean MethodData out
-  class MethodDataCleaner : public KlassClosure {
-   public:
-    MethodDataCleaner() {}
+    AdjustAndCleanMetadata(Thread* t) : _thread(t) {}
     void do_klass(Klass* k);
   };
  public:
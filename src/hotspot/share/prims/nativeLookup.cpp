@@ -179,10 +179,10 @@ char* NativeLookup::pure_jni_name(const methodHandle& method) {
 }
 
 
-char* NativeLookup::critical_jni_name(const methodHandle& method) {
+char* NativeLookup::critical_jni_name(const methodHandle& method, bool trivial) {
   stringStream st;
   // Prefix
-  st.print("JavaCritical_");
+  st.print(trivial ? "JavaTrivial_" : "JavaCritical_");
   // Klass name
   if (!map_escaped_name_on(&st, method->klass_name())) {
     return NULL;
@@ -367,9 +367,12 @@ address NativeLookup::lookup_entry(const methodHandle& method, bool& in_base_lib
 }
 
 // Check all the formats of native implementation name to see if there is one
-// for the specified method.
-address NativeLookup::lookup_critical_entry(const methodHandle& method) {
+// for the specified method. With TrivialJNINatives, a JavaTrivial_ entry
+// point is preferred over a JavaCritical_ one and trivial is set when it
+// is found.
+address NativeLookup::lookup_critical_entry(const methodHandle& method, bool& trivial) {
   assert(CriticalJNINatives, "or should not be here");
+  trivial = false;
 
   if (method->is_synchronized() ||
       !method->is_static()) {
@@ -402,7 +405,13 @@ address NativeLookup::lookup_critical_entry(const methodHandle& method) {
   address entry = NULL;
 
   if (dll != NULL) {
-    entry = lookup_critical_style(dll, method, args_size);
+    if (TrivialJNINatives) {
+      entry = lookup_critical_style(dll, method, args_size, true);
+      trivial = entry != NULL;
+    }
+    if (entry == NULL) {
+      entry = lookup_critical_style(dll, method, args_size, false);
+    }
     // Close the handle to avoid keeping the library alive if the native method holder is unloaded.
     // This is fine because the library is still kept alive by JNI (see JVM_LoadLibrary). As soon
     // as the holder class and the library are unloaded (see JVM_UnloadLibrary), the native wrapper
@@ -431,9 +440,9 @@ void* NativeLookup::dll_load(const methodHandle& method) {
   return NULL;
 }
 
-address NativeLookup::lookup_critical_style(void* dll, const methodHandle& method, int args_size) {
+address NativeLookup::lookup_critical_style(void* dll, const methodHandle& method, int args_size, bool trivial) {
   address entry = NULL;
-  const char* critical_name = critical_jni_name(method);
+  const char* critical_name = critical_jni_name(method, trivial);
   if (critical_name == NULL) {
     // JNI name mapping rejected this method so return
     // NULL to indicate UnsatisfiedLinkError should be thrown.
@@ -36,12 +36,12 @@ class NativeLookup : AllStatic {
   // JNI name computation
   static char* pure_jni_name(const methodHandle& method);
   static char* long_jni_name(const methodHandle& method);
-  static char* critical_jni_name(const methodHandle& method);
+  static char* critical_jni_name(const methodHandle& method, bool trivial);
 
   // Style specific lookup
   static address lookup_style(const methodHandle& method, char* pure_name, const char* long_name, int args_size, bool os_style, bool& in_base_library, TRAPS);
   static address lookup_critical_style(void* dll, const char* pure_name, const char* long_name, int args_size, bool os_style);
-  static address lookup_critical_style(void* dll, const methodHandle& method, int args_size);
+  static address lookup_critical_style(void* dll, const methodHandle& method, int args_size, bool trivial);
   static address lookup_base (const methodHandle& method, bool& in_base_library, TRAPS);
   static address lookup_entry(const methodHandle& method, bool& in_base_library, TRAPS);
   static address lookup_entry_prefixed(const methodHandle& method, bool& in_base_library, TRAPS);
@@ -51,7 +51,7 @@ class NativeLookup : AllStatic {
  public:
   // Lookup native function. May throw UnsatisfiedLinkError.
   static address lookup(const methodHandle& method, bool& in_base_library, TRAPS);
-  static address lookup_critical_entry(const methodHandle& method);
+  static address lookup_critical_entry(const methodHandle& method, bool& trivial);
 
   // Lookup native functions in base library.
   static address base_library_lookup(const char* class_name, const char* method_name, const char* signature);
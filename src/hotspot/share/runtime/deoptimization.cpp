@@ -33,6 +33,7 @@
 #include "interpreter/bytecode.hpp"
 #include "interpreter/interpreter.hpp"
 #include "interpreter/oopMapCache.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
@@ -1773,6 +1774,14 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
     //   many "lukewarm" deoptimizations.  The code which enforces this
     //   limit is elsewhere (class nmethod, class Method).
     //
+    //   4. If a method is recompiled DeoptStormThreshold times for the
+    //   same reason R within DeoptStormWindow milliseconds, each time at
+    //   a trap point that had already caused a recompilation, it is in a
+    //   deoptimization storm.  With tiered compilation the method is then
+    //   not compiled at the highest tier for the next DeoptStormWindow
+    //   milliseconds and runs the profiled C1 code meanwhile.  Repeated
+    //   recompiles are already preceded by a reprofile (see below).
+    //
     // Note that the per-BCI 'is_recompiled' bit gives the compiler one chance
     // to recompile at each bytecode independently of the per-BCI cutoff.
     //
@@ -1796,6 +1805,7 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
     bool make_not_entrant = false;
     bool make_not_compilable = false;
     bool reprofile = false;
+    uint storm_recompiles = 0;
     switch (action) {
     case Action_none:
       // Keep the old code.
@@ -1850,6 +1860,7 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
     // to use the MDO to detect hot deoptimization points and control
     // aggressive optimization.
     bool inc_recompile_count = false;
+    bool repeated_recompile = false;
     ProfileData* pdata = NULL;
     if (ProfileTraps && !is_client_compilation_mode_vm() && update_trap_state && trap_mdo != NULL) {
       assert(trap_mdo == get_method_data(thread, profiled_method, false), "sanity");
@@ -1921,6 +1932,7 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
       // for a while to exercise it more thoroughly.
       if (make_not_entrant && maybe_prior_recompile && maybe_prior_trap) {
         reprofile = true;
+        repeated_recompile = true;
       }
     }
 
@@ -1955,6 +1967,25 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
       if (reason == Reason_tenured && trap_mdo != NULL) {
         trap_mdo->inc_tenure_traps();
       }
+
+      // Count the recompilation per reason to detect a storm.  Only
+      // repeated recompilations at a trap point that already caused one
+      // count (for reasons not recorded per bytecode, repeated ones in the
+      // method): a first recompile at each of many sites is normal profile
+      // completion, not oscillation.  Counting only after
+      // make_not_entrant() succeeded ignores the other threads trapping in
+      // the same nmethod.  The count goes on the compiled method, which is
+      // what gets recompiled and throttled, not on an inlined callee that
+      // happened to contain the trap.
+      MethodData* nm_mdo = nm->method()->method_data();
+      if (DeoptStormThreshold > 0 && repeated_recompile && nm_mdo != NULL &&
+          (uint)reason < MethodData::trap_reason_limit()) {
+        jlong now = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+        uint recompiles = nm_mdo->inc_reason_recompile_count(reason, now, (jlong)DeoptStormWindow);
+        if (recompiles == DeoptStormThreshold) {
+          storm_recompiles = recompiles;
+        }
+      }
     }
 
     if (inc_recompile_count) {
@@ -1982,6 +2013,10 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
       nm->method()->set_not_compilable(CompLevel_full_optimization);
     }
 
+    if (storm_recompiles != 0) {
+      report_deoptimization_storm(thread, nm, trap_method(), reason, storm_recompiles);
+    }
+
   } // Free marked resources
 
 }
@@ -2301,6 +2336,42 @@ juint Deoptimization::_deoptimization_hist
         [Deoptimization::BC_CASE_LIMIT]
   = {0};
 
+volatile juint Deoptimization::_deoptimization_storms[Deoptimization::Reason_LIMIT] = {0};
+
+void Deoptimization::report_deoptimization_storm(JavaThread* thread, CompiledMethod* nm,
+                                                 Method* trap_method, DeoptReason reason,
+                                                 uint recompiles) {
+  Atomic::inc(&_deoptimization_storms[reason]);
+
+  // Keep the method at the profiled C1 tier for a window, after which
+  // it may be compiled at the highest tier again: see
+  // TieredThresholdPolicy::compile().
+  Method* m = nm->method();
+  bool pinned = false;
+  MethodData* mdo = m->method_data();
+  if (TieredCompilation && nm->comp_level() == CompLevel_full_optimization && mdo != NULL) {
+    jlong now = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+    mdo->set_deopt_storm_end(now + (jlong)DeoptStormWindow);
+    pinned = true;
+  }
+
+  ResourceMark rm(thread);
+  Events::log_deopt_message(thread, "Deoptimization storm: reason=%s recompiles=%u method=%s%s",
+                            trap_reason_name(reason), recompiles,
+                            trap_method->name_and_sig_as_C_string(),
+                            pinned ? " (not compiled at the highest tier for DeoptStormWindow)" : "");
+
+  EventDeoptimizationStorm event;
+  if (event.should_commit()) {
+    event.set_method(m);
+    event.set_trapMethod(trap_method);
+    event.set_reason(trap_reason_name(reason));
+    event.set_recompileCount(recompiles);
+    event.set_pinned(pinned);
+    event.commit();
+  }
+}
+
 enum {
   LSB_BITS = 8,
   LSB_MASK = right_n_bits(LSB_BITS)
@@ -2346,14 +2417,23 @@ jint Deoptimization::deoptimization_count(DeoptReason reason) {
 }
 
 void Deoptimization::print_statistics() {
-  juint total = total_deoptimization_count();
-  juint account = total;
-  if (total != 0) {
+  if (total_deoptimization_count() != 0) {
     ttyLocker ttyl;
     if (xtty != NULL)  xtty->head("statistics type='deoptimization'");
-    tty->print_cr("Deoptimization traps recorded:");
+    print_statistics_on(tty);
+    if (xtty != NULL)  xtty->tail("statistics");
+  }
+}
+
+void Deoptimization::print_statistics_on(outputStream* st) {
+  juint total = total_deoptimization_count();
+  juint account = total;
+  if (total == 0) {
+    st->print_cr("No deoptimization traps recorded");
+  } else {
+    st->print_cr("Deoptimization traps recorded:");
     #define PRINT_STAT_LINE(name, r) \
-      tty->print_cr("  %4d (%4.1f%%) %s", (int)(r), ((r) * 100.0) / total, name);
+      st->print_cr("  %4d (%4.1f%%) %s", (int)(r), ((r) * 100.0) / total, name);
     PRINT_STAT_LINE("total", total);
     // For each non-zero entry in the histogram, print the reason,
     // the action, and (if specifically known) the type of bytecode.
@@ -2372,7 +2452,7 @@ void Deoptimization::print_statistics() {
                     trap_action_name(action),
                     Bytecodes::is_defined(bc)? Bytecodes::name(bc): "other");
             juint r = counter >> LSB_BITS;
-            tty->print_cr("  %40s: " UINT32_FORMAT " (%.1f%%)", name, r, (r * 100.0) / total);
+            st->print_cr("  %40s: " UINT32_FORMAT " (%.1f%%)", name, r, (r * 100.0) / total);
             account -= r;
           }
         }
@@ -2382,7 +2462,20 @@ void Deoptimization::print_statistics() {
       PRINT_STAT_LINE("unaccounted", account);
     }
     #undef PRINT_STAT_LINE
-    if (xtty != NULL)  xtty->tail("statistics");
+  }
+
+  st->print_cr("Deoptimization storms (DeoptStormThreshold=" UINTX_FORMAT ", DeoptStormWindow=" UINTX_FORMAT "ms):",
+               DeoptStormThreshold, DeoptStormWindow);
+  bool any = false;
+  for (int reason = 0; reason < Reason_LIMIT; reason++) {
+    juint storms = _deoptimization_storms[reason];
+    if (storms != 0) {
+      st->print_cr("  %40s: " UINT32_FORMAT " methods", trap_reason_name(reason), storms);
+      any = true;
+    }
+  }
+  if (!any) {
+    st->print_cr("  none");
   }
 }
 #else // COMPILER2_OR_JVMCI
@@ -2401,6 +2494,10 @@ void Deoptimization::print_statistics() {
   // no output
 }
 
+void Deoptimization::print_statistics_on(outputStream* st) {
+  st->print_cr("No deoptimization traps recorded");
+}
+
 void
 Deoptimization::update_method_data_from_interpreter(MethodData* trap_mdo, int trap_bci, int reason) {
   // no udpate
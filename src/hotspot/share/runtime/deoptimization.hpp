@@ -294,6 +294,8 @@ JVMCI_ONLY(public:)
   static void gather_statistics(DeoptReason reason, DeoptAction action,
                                 Bytecodes::Code bc = Bytecodes::_illegal);
   static void print_statistics();
+  // Print the trap histogram and the deoptimization storms seen so far
+  static void print_statistics_on(outputStream* st);
 
   // How much room to adjust the last frame's SP by, to make space for
   // the callee's interpreter frame (which expects locals to be next to
@@ -453,6 +455,13 @@ JVMCI_ONLY(public:)
   static juint _deoptimization_hist[Reason_LIMIT][1+Action_LIMIT][BC_CASE_LIMIT];
   // Note:  Histogram array size is 1-2 Kb.
 
+  // Number of methods that reached DeoptStormThreshold, per reason
+  static volatile juint _deoptimization_storms[Reason_LIMIT];
+
+  static void report_deoptimization_storm(JavaThread* thread, CompiledMethod* nm,
+                                          Method* trap_method, DeoptReason reason,
+                                          uint recompiles);
+
  public:
   static void update_method_data_from_interpreter(MethodData* trap_mdo, int trap_bci, int reason);
 };
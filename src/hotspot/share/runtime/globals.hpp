@@ -293,6 +293,10 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Use large page memory in metaspace. "                            \
           "Only used if UseLargePages is enabled.")                         \
                                                                             \
+  product(bool, UseLargePagesInCodeCache, true,                             \
+          "Use large page memory for the code cache. "                      \
+          "Only used if UseLargePages is enabled.")                         \
+                                                                            \
   product(bool, UseNUMA, false,                                             \
           "Use NUMA if available")                                          \
                                                                             \
@@ -435,6 +439,11 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
   product(bool, CriticalJNINatives, true,                                   \
           "Check for critical JNI entry points")                            \
                                                                             \
+  experimental(bool, TrivialJNINatives, false,                              \
+          "Check for JavaTrivial_ JNI entry points. They are called like "  \
+          "critical natives but without leaving the Java thread state so "  \
+          "they must be short and must not block or call into the VM")      \
+                                                                            \
   product(bool, UseLegacyJNINameEscaping, false,                            \
           "Use the original JNI name escaping scheme")                      \
                                                                             \
@@ -1773,6 +1782,20 @@ define_pd_global(uint64_t,MaxRAM,                    1ULL*G);
           "Per-BCI limit on repeated recompilation (-1=>'Inf')")            \
           range(-1, max_intx)                                               \
                                                                             \
+  product(uintx, DeoptStormThreshold, 0,                                    \
+          "Number of repeated recompilations of a method for the same "     \
+          "trap reason, at trap points that already caused one, within "    \
+          "DeoptStormWindow after which it is treated as a deoptimization " \
+          "storm: with tiered compilation it is not compiled at the "       \
+          "highest tier for the next DeoptStormWindow (0 = off)")           \
+          range(0, max_jubyte)                                              \
+                                                                            \
+  product(uintx, DeoptStormWindow, 60000,                                   \
+          "Time window in milliseconds over which the recompilations "      \
+          "counted against DeoptStormThreshold accumulate, and for which "  \
+          "a method in a deoptimization storm stays at the lower tiers")    \
+          range(1, max_jint)                                                \
+                                                                            \
   product(intx, PerMethodTrapLimit,  100,                                   \
           "Limit on traps (of one kind) in a method (includes inlines)")    \
           range(0, max_jint)                                                \
@@ -155,6 +155,7 @@ void PerfMemory::initialize() {
   _prologue->used = 0;
   _prologue->overflow = 0;
   _prologue->mod_time_stamp = 0;
+  _prologue->sample_seq = 0;
 
   OrderAccess::release_store(&_initialized, 1);
 }
@@ -240,6 +241,56 @@ void PerfMemory::mark_updated() {
   _prologue->mod_time_stamp = os::elapsed_counter();
 }
 
+// Only the StatSampler updates sampled entries, and it does so from a
+// single thread at a time (the WatcherThread, or the thread disengaging
+// the sampler once the periodic task is gone), so there is one writer.
+void PerfMemory::begin_sample_update() {
+  if (!is_usable()) return;
+
+  begin_sample_update(_prologue);
+}
+
+void PerfMemory::end_sample_update() {
+  if (!is_usable()) return;
+
+  end_sample_update(_prologue);
+}
+
+void PerfMemory::begin_sample_update(PerfDataPrologue* prologue) {
+  jint seq = prologue->sample_seq;
+  assert((seq & 1) == 0, "sample update already in progress");
+  prologue->sample_seq = seq + 1;
+  // make the odd sequence number visible before any sampled value
+  OrderAccess::storestore();
+}
+
+void PerfMemory::end_sample_update(PerfDataPrologue* prologue) {
+  jint seq = prologue->sample_seq;
+  assert((seq & 1) == 1, "no sample update in progress");
+  // publish all sampled values before the even sequence number
+  OrderAccess::release_store(&prologue->sample_seq, seq + 1);
+}
+
+bool PerfMemory::copy_sampled(const PerfDataPrologue* prologue, void* to,
+                              const void* from, size_t size, int max_tries) {
+  const volatile jint* seq_addr = &prologue->sample_seq;
+  for (int i = 0; i < max_tries; i++) {
+    jint seq = OrderAccess::load_acquire(seq_addr);
+    if ((seq & 1) != 0) {
+      // update in progress
+      SpinPause();
+      continue;
+    }
+    memcpy(to, from, size);
+    // read all sampled values before checking the sequence number again
+    OrderAccess::loadload();
+    if (*seq_addr == seq) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // Returns the complete path including the file name of performance data file.
 // Caller is expected to release the allocated memory.
 char* PerfMemory::get_perfdata_file_path() {
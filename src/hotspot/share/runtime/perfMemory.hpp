@@ -69,8 +69,29 @@ typedef struct {
   jlong  mod_time_stamp;     // time stamp of last structural modification
   jint   entry_offset;       // offset of the first PerfDataEntry
   jint   num_entries;        // number of allocated PerfData entries
+  jint   sample_seq;         // sampling sequence number, odd while the
+                             // sampled entries are being updated
 } PerfDataPrologue;
 
+/*
+ * The sample_seq field of the prologue implements a sequence lock over
+ * the values of the sampled (PerfData::V_Variable, sampled by the
+ * StatSampler) entries. It is incremented to an odd value before the
+ * StatSampler starts updating the sampled entries and to the next even
+ * value once all of them have been written. A reader that wants a
+ * consistent snapshot of the sampled entries:
+ *
+ *   1. reads sample_seq, retrying while it is odd,
+ *   2. copies the values it is interested in,
+ *   3. reads sample_seq again, and retries from 1 if it changed.
+ *
+ * PerfMemory::copy_sampled() implements these steps.
+ *
+ * The field was appended to the prologue; readers that locate entries
+ * through entry_offset are not affected by it. Counters that are
+ * updated directly by the VM (not sampled) are not covered.
+ */
+
 /* The PerfDataEntry structure defines the fixed portion of an entry
  * in the PerfData memory region. The PerfDataBuffer Java libraries
  * are aware of this structure and need to be changed when this
@@ -145,6 +166,18 @@ class PerfMemory : AllStatic {
     }
     static void mark_updated();
 
+    // bracket an update of the sampled entries, see sample_seq above
+    static void begin_sample_update();
+    static void end_sample_update();
+    static void begin_sample_update(PerfDataPrologue* prologue);
+    static void end_sample_update(PerfDataPrologue* prologue);
+
+    // reader side of the sample_seq protocol: copy size bytes of sampled
+    // values at from, in the region of the given prologue, to to. Returns
+    // false if no consistent copy was made within max_tries attempts.
+    static bool copy_sampled(const PerfDataPrologue* prologue, void* to,
+                             const void* from, size_t size, int max_tries);
+
     // methods for attaching to and detaching from the PerfData
     // memory segment of another JVM process on the same system.
     static void attach(const char* user, int vmid, PerfMemoryMode mode,
@@ -2816,6 +2816,7 @@ void AdapterHandlerLibrary::create_native_wrapper(const methodHandle& method) {
   ResourceMark rm;
   nmethod* nm = NULL;
   address critical_entry = NULL;
+  bool trivial = false;
 
   assert(method->is_native(), "must be native");
   assert(method->is_method_handle_intrinsic() ||
@@ -2823,7 +2824,7 @@ void AdapterHandlerLibrary::create_native_wrapper(const methodHandle& method) {
 
   if (CriticalJNINatives && !method->is_method_handle_intrinsic()) {
     // We perform the I/O with transition to native before acquiring AdapterHandlerLibrary_lock.
-    critical_entry = NativeLookup::lookup_critical_entry(method);
+    critical_entry = NativeLookup::lookup_critical_entry(method, trivial);
   }
 
   {
@@ -2833,6 +2834,7 @@ void AdapterHandlerLibrary::create_native_wrapper(const methodHandle& method) {
     if (method->code() != NULL) {
       return;
     }
+    method->set_trivial_native(trivial);
 
     const int compile_id = CompileBroker::assign_compile_id(method, CompileBroker::standard_entry_bci);
     assert(compile_id > 0, "Must generate native wrapper");
@@ -33,6 +33,7 @@
 #include "runtime/javaCalls.hpp"
 #include "runtime/os.hpp"
 #include "runtime/perfData.inline.hpp"
+#include "runtime/perfMemory.hpp"
 #include "runtime/statSampler.hpp"
 #include "runtime/vm_version.hpp"
 
@@ -136,10 +137,12 @@ void StatSampler::sample_data(PerfDataList* list) {
 
   assert(list != NULL, "null list unexpected");
 
+  PerfMemory::begin_sample_update();
   for (int index = 0; index < list->length(); index++) {
     PerfData* item = list->at(index);
     item->sample();
   }
+  PerfMemory::end_sample_update();
 }
 
 /*
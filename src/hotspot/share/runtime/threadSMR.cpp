@@ -204,43 +204,25 @@ class ThreadScanHashtable : public CHeapObj<mtThread> {
   }
 };
 
-// Closure to gather JavaThreads indirectly referenced by hazard ptrs
-// (ThreadsList references) into a hash table. This closure handles part 2
-// of the dance - adding all the JavaThreads referenced by the hazard
-// pointer (ThreadsList reference) to the hash table.
+// Closure to determine if a JavaThread is protected by a hazard ptr
+// (ThreadsList reference). The caller has gathered the ThreadsLists that
+// contain the JavaThread into a hash table so each hazard ptr is checked
+// with a single lookup instead of hashing all the JavaThreads on its
+// ThreadsList.
 //
-class AddThreadHazardPointerThreadClosure : public ThreadClosure {
+class ScanHazardPtrFindProtectingListClosure : public ThreadClosure {
  private:
   ThreadScanHashtable *_table;
-
+  bool _found;
  public:
-  AddThreadHazardPointerThreadClosure(ThreadScanHashtable *table) : _table(table) {}
+  ScanHazardPtrFindProtectingListClosure(ThreadScanHashtable *table) : _table(table), _found(false) {}
 
-  virtual void do_thread(Thread *thread) {
-    if (!_table->has_entry((void*)thread)) {
-      // The same JavaThread might be on more than one ThreadsList or
-      // more than one thread might be using the same ThreadsList. In
-      // either case, we only need a single entry for a JavaThread.
-      _table->add_entry((void*)thread);
-    }
-  }
-};
-
-// Closure to gather JavaThreads indirectly referenced by hazard ptrs
-// (ThreadsList references) into a hash table. This closure handles part 1
-// of the dance - hazard ptr chain walking and dispatch to another
-// closure.
-//
-class ScanHazardPtrGatherProtectedThreadsClosure : public ThreadClosure {
- private:
-  ThreadScanHashtable *_table;
- public:
-  ScanHazardPtrGatherProtectedThreadsClosure(ThreadScanHashtable *table) : _table(table) {}
+  bool found() const { return _found; }
 
   virtual void do_thread(Thread *thread) {
     assert_locked_or_safepoint(Threads_lock);
 
-    if (thread == NULL) return;
+    if (thread == NULL || _found) return;
 
     // This code races with ThreadsSMRSupport::acquire_stable_list() which
     // is lock-free so we have to handle some special situations.
@@ -272,8 +254,9 @@ class ScanHazardPtrGatherProtectedThreadsClosure : public ThreadClosure {
     // ThreadsList that has been removed but not freed. In either case,
     // the hazard ptr is protecting all the JavaThreads on that
     // ThreadsList.
-    AddThreadHazardPointerThreadClosure add_cl(_table);
-    current_list->threads_do(&add_cl);
+    if (_table->has_entry((void*)current_list)) {
+      _found = true;
+    }
   }
 };
 
@@ -299,6 +282,11 @@ class ScanHazardPtrGatherThreadsListClosure : public ThreadClosure {
     // published), then the only side effect is that we might keep a
     // to-be-deleted ThreadsList alive a little longer.
     threads = Thread::untag_hazard_ptr(threads);
+    if (threads == ThreadsSMRSupport::get_java_thread_list()) {
+      // Most hazard ptrs refer to the current ThreadsList which is
+      // never on the to-delete list so there is no need to record it.
+      return;
+    }
     if (!_table->has_entry((void*)threads)) {
       _table->add_entry((void*)threads);
     }
@@ -850,42 +838,47 @@ void ThreadsSMRSupport::free_list(ThreadsList* threads) {
 bool ThreadsSMRSupport::is_a_protected_JavaThread(JavaThread *thread) {
   assert_locked_or_safepoint(Threads_lock);
 
-  // Hash table size should be first power of two higher than twice
-  // the length of the Threads list.
-  int hash_table_size = MIN2((int)get_java_thread_list()->length(), 32) << 1;
-  hash_table_size--;
-  hash_table_size |= hash_table_size >> 1;
-  hash_table_size |= hash_table_size >> 2;
-  hash_table_size |= hash_table_size >> 4;
-  hash_table_size |= hash_table_size >> 8;
-  hash_table_size |= hash_table_size >> 16;
-  hash_table_size++;
+  // An exiting JavaThread has already been removed from _java_thread_list
+  // so it can only be protected through a ThreadsList on the to-delete
+  // list. There are usually very few of those, so gather the ones that
+  // contain the JavaThread first; each hazard ptr is then checked with a
+  // single lookup, which keeps the scan linear in the number of threads
+  // instead of hashing every JavaThread of every hazard ptr'ed ThreadsList.
+  ThreadScanHashtable *scan_table = NULL;
+  bool thread_is_protected = false;
+  ThreadsList* current = get_java_thread_list();
+  while (current != NULL) {
+    if (current->includes(thread)) {
+      if (scan_table == NULL) {
+        scan_table = new ThreadScanHashtable(32);
+      }
+      scan_table->add_entry((void*)current);
+    }
+    current = (current == get_java_thread_list()) ? _to_delete_list : current->next_list();
+  }
+  if (scan_table == NULL) {
+    // No ThreadsList left that contains the JavaThread.
+    return false;
+  }
 
-  // Gather a hash table of the JavaThreads indirectly referenced by
-  // hazard ptrs.
-  ThreadScanHashtable *scan_table = new ThreadScanHashtable(hash_table_size);
-  ScanHazardPtrGatherProtectedThreadsClosure scan_cl(scan_table);
+  ScanHazardPtrFindProtectingListClosure scan_cl(scan_table);
   threads_do(&scan_cl);
+  thread_is_protected = scan_cl.found();
   OrderAccess::acquire(); // Must order reads of hazard ptr before reads of
                           // nested reference counters
 
-  // Walk through the linked list of pending freeable ThreadsLists
-  // and include the ones that are currently in use by a nested
-  // ThreadsListHandle in the search set.
-  ThreadsList* current = _to_delete_list;
-  while (current != NULL) {
-    if (current->_nested_handle_cnt != 0) {
-      // 'current' is in use by a nested ThreadsListHandle so the hazard
-      // ptr is protecting all the JavaThreads on that ThreadsList.
-      AddThreadHazardPointerThreadClosure add_cl(scan_table);
-      current->threads_do(&add_cl);
+  if (!thread_is_protected) {
+    // Walk through the linked list of pending freeable ThreadsLists
+    // and check the ones that are currently in use by a nested
+    // ThreadsListHandle.
+    for (current = _to_delete_list; current != NULL; current = current->next_list()) {
+      if (current->_nested_handle_cnt != 0 && scan_table->has_entry((void*)current)) {
+        // 'current' is in use by a nested ThreadsListHandle so the hazard
+        // ptr is protecting all the JavaThreads on that ThreadsList.
+        thread_is_protected = true;
+        break;
+      }
     }
-    current = current->next_list();
-  }
-
-  bool thread_is_protected = false;
-  if (scan_table->has_entry((void*)thread)) {
-    thread_is_protected = true;
   }
   delete scan_table;
   return thread_is_protected;
@@ -28,10 +28,12 @@
 #include "memory/resourceArea.hpp"
 #include "runtime/arguments.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/os.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/tieredThresholdPolicy.hpp"
 #include "code/scopeDesc.hpp"
 #include "oops/method.inline.hpp"
+#include "oops/methodData.hpp"
 #if INCLUDE_JVMCI
 #include "jvmci/jvmciRuntime.hpp"
 #endif
@@ -405,6 +407,12 @@ nmethod* TieredThresholdPolicy::event(const methodHandle& method, const methodHa
   return NULL;
 }
 
+static bool in_deoptimization_storm(Method* method) {
+  MethodData* mdo = method->method_data();
+  return DeoptStormThreshold > 0 && mdo != NULL &&
+         mdo->in_deopt_storm(os::javaTimeNanos() / NANOSECS_PER_MILLISEC);
+}
+
 // Check if the method can be compiled, change level if necessary
 void TieredThresholdPolicy::compile(const methodHandle& mh, int bci, CompLevel level, JavaThread* thread) {
   assert(level <= TieredStopAtLevel, "Invalid compilation level");
@@ -429,6 +437,12 @@ void TieredThresholdPolicy::compile(const methodHandle& mh, int bci, CompLevel l
     return;
   }
 
+  // A method in a deoptimization storm keeps running profiled C1 code until
+  // the storm window is over, see Deoptimization::report_deoptimization_storm().
+  if (level == CompLevel_full_optimization && in_deoptimization_storm(mh())) {
+    level = CompLevel_full_profile;
+  }
+
   // Check if the method can be compiled. If it cannot be compiled with C1, continue profiling
   // in the interpreter and then compile with C2 (the transition function will request that,
   // see common() ). If the method cannot be compiled with C2 but still can with C1, compile it with
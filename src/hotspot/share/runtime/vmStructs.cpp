@@ -450,6 +450,7 @@ typedef PaddedEnd<ObjectMonitor>              PaddedObjectMonitor;
   nonstatic_field(PerfDataPrologue,            mod_time_stamp,                                jlong)                                 \
   nonstatic_field(PerfDataPrologue,            entry_offset,                                  jint)                                  \
   nonstatic_field(PerfDataPrologue,            num_entries,                                   jint)                                  \
+  nonstatic_field(PerfDataPrologue,            sample_seq,                                    jint)                                  \
                                                                                                                                      \
   nonstatic_field(PerfDataEntry,               entry_length,                                  jint)                                  \
   nonstatic_field(PerfDataEntry,               name_offset,                                   jint)                                  \
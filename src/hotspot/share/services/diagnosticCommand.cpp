@@ -35,12 +35,15 @@
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
+#include "runtime/deoptimization.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/flags/jvmFlag.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
+#include "runtime/threadSMR.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -48,7 +51,9 @@
 #include "services/management.hpp"
 #include "services/writeableFlags.hpp"
 #include "utilities/debug.hpp"
+#include "utilities/events.hpp"
 #include "utilities/formatBuffer.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/macros.hpp"
 
 
@@ -82,6 +87,7 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMDynamicLibrariesDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMUptimeDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMInfoDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<VMEventsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SystemGCDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RunFinalizationDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapInfoDCmd>(full_export, true, false));
@@ -103,11 +109,13 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<JVMTIDataDumpDCmd>(full_export, true, false));
 #endif // INCLUDE_JVMTI
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ThreadDumpDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ThreadTopDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassLoaderStatsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassLoaderHierarchyDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompileQueueDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeListDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<DeoptStatsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TouchedMethodsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeHeapAnalyticsDCmd>(full_export, true, false));
 
@@ -436,6 +444,37 @@ void VMInfoDCmd::execute(DCmdSource source, TRAPS) {
   VMError::print_vm_info(_output);
 }
 
+VMEventsDCmd::VMEventsDCmd(outputStream* output, bool heap) :
+                           DCmdWithParser(output, heap),
+  _log("log", "Only print the logs whose name contains this string", "STRING", false),
+  _max("max", "Maximum number of events to print per log, -1 for all", "INT", false, "-1") {
+  _dcmdparser.add_dcmd_option(&_log);
+  _dcmdparser.add_dcmd_option(&_max);
+}
+
+void VMEventsDCmd::execute(DCmdSource source, TRAPS) {
+  if (!LogEvents) {
+    output()->print_cr("Event logging is disabled (-XX:-LogEvents).");
+    return;
+  }
+  // The event logs are lock-free, printing them does not hold up the
+  // threads that keep logging.
+  // Any negative max prints all events.
+  jlong max = MAX2(MIN2(_max.value(), (jlong)max_jint), (jlong)-1);
+  Events::print_all(output(), _log.value(), (int)max);
+}
+
+int VMEventsDCmd::num_arguments() {
+  ResourceMark rm;
+  VMEventsDCmd* dcmd = new VMEventsDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 void SystemGCDCmd::execute(DCmdSource source, TRAPS) {
   Universe::heap()->collect(GCCause::_dcmd_gc_run);
 }
@@ -658,6 +697,88 @@ int ThreadDumpDCmd::num_arguments() {
   }
 }
 
+ThreadTopDCmd::ThreadTopDCmd(outputStream* output, bool heap) :
+                             DCmdWithParser(output, heap),
+  _by_allocation("-a", "sort by allocated bytes instead of CPU time", "BOOLEAN", false, "false"),
+  _count("count", "number of threads to print", "INT", false, "10") {
+  _dcmdparser.add_dcmd_option(&_by_allocation);
+  _dcmdparser.add_dcmd_argument(&_count);
+}
+
+struct ThreadTopEntry {
+  JavaThread* _thread;
+  jlong       _cpu_time;    // nanoseconds, -1 if unavailable
+  jlong       _allocated;   // bytes
+  const char* _name;        // resource allocated, copied under Threads_lock
+};
+
+static int compare_cpu_time(ThreadTopEntry* a, ThreadTopEntry* b) {
+  return a->_cpu_time < b->_cpu_time ? 1 : (a->_cpu_time > b->_cpu_time ? -1 : 0);
+}
+
+static int compare_allocated(ThreadTopEntry* a, ThreadTopEntry* b) {
+  return a->_allocated < b->_allocated ? 1 : (a->_allocated > b->_allocated ? -1 : 0);
+}
+
+void ThreadTopDCmd::execute(DCmdSource source, TRAPS) {
+  if (_count.value() < 0) {
+    output()->print_cr("Invalid count: " JLONG_FORMAT, _count.value());
+    return;
+  }
+  ResourceMark rm(THREAD);
+  // The ThreadsListHandle keeps the threads alive while they are sampled.
+  // Reading another thread's name still requires the Threads_lock, which
+  // is only taken to copy the names of the threads actually printed.
+  ThreadsListHandle tlh(THREAD);
+  const bool cpu_time_supported = os::is_thread_cpu_time_supported();
+  GrowableArray<ThreadTopEntry> entries(tlh.length());
+  for (uint i = 0; i < tlh.length(); i++) {
+    JavaThread* jt = tlh.list()->thread_at(i);
+    if (jt->threadObj() == NULL || jt->is_exiting()) {
+      continue;
+    }
+    ThreadTopEntry e;
+    e._thread = jt;
+    e._cpu_time = cpu_time_supported ? os::thread_cpu_time(jt) : -1;
+    e._allocated = jt->cooked_allocated_bytes();
+    e._name = NULL;
+    entries.append(e);
+  }
+  entries.sort(_by_allocation.value() ? compare_allocated : compare_cpu_time);
+
+  const int count = (int)MIN2(_count.value(), (jlong)entries.length());
+  {
+    MutexLocker ml(Threads_lock);
+    for (int i = 0; i < count; i++) {
+      entries.adr_at(i)->_name = entries.at(i)._thread->get_thread_name();
+    }
+  }
+  output()->print_cr("Top %d of %d Java threads by %s:", count, entries.length(),
+                     _by_allocation.value() ? "allocated bytes" : "CPU time");
+  output()->print_cr("%12s %16s  %s", "CPU ms", "Allocated KB", "Thread");
+  for (int i = 0; i < count; i++) {
+    const ThreadTopEntry& e = entries.at(i);
+    if (e._cpu_time >= 0) {
+      output()->print("%12.1f ", (double)e._cpu_time / NANOSECS_PER_MILLISEC);
+    } else {
+      output()->print("%12s ", "n/a");
+    }
+    output()->print_cr(SIZE_FORMAT_W(16) "  \"%s\" tid=" INTPTR_FORMAT,
+                       (size_t)e._allocated / K, e._name, p2i(e._thread));
+  }
+}
+
+int ThreadTopDCmd::num_arguments() {
+  ResourceMark rm;
+  ThreadTopDCmd* dcmd = new ThreadTopDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 // Enhanced JMX Agent support
 
 JMXStartRemoteDCmd::JMXStartRemoteDCmd(outputStream *output, bool heap_allocated) :
@@ -948,6 +1069,10 @@ void CodeCacheDCmd::execute(DCmdSource source, TRAPS) {
   CodeCache::print_layout(output());
 }
 
+void DeoptStatsDCmd::execute(DCmdSource source, TRAPS) {
+  Deoptimization::print_statistics_on(output());
+}
+
 //---<  BEGIN  >--- CodeHeap State Analytics.
 CodeHeapAnalyticsDCmd::CodeHeapAnalyticsDCmd(outputStream* output, bool heap) :
                                              DCmdWithParser(output, heap),
@@ -257,6 +257,28 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class VMEventsDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _log;
+  DCmdArgument<jlong> _max;
+public:
+  VMEventsDCmd(outputStream* output, bool heap);
+  static const char* name() { return "VM.events"; }
+  static const char* description() {
+    return "Print the VM internal event logs, as printed in hs_err files.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class SystemGCDCmd : public DCmd {
 public:
   SystemGCDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
@@ -467,6 +489,28 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class ThreadTopDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<bool>  _by_allocation;
+  DCmdArgument<jlong> _count;
+public:
+  ThreadTopDCmd(outputStream* output, bool heap);
+  static const char* name() { return "Thread.top"; }
+  static const char* description() {
+    return "Print the Java threads that used the most CPU time or allocated the most memory.";
+  }
+  static const char* impact() {
+    return "Low: Depends on the number of threads.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 // Enhanced JMX Agent support
 
 class JMXStartRemoteDCmd : public DCmdWithParser {
@@ -644,6 +688,27 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class DeoptStatsDCmd : public DCmd {
+public:
+  DeoptStatsDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() {
+    return "Compiler.deopt_stats";
+  }
+  static const char* description() {
+    return "Print deoptimization trap counts by reason and action, and deoptimization storms.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 //---<  BEGIN  >--- CodeHeap State Analytics.
 class CodeHeapAnalyticsDCmd : public DCmdWithParser {
 protected:
@@ -24,12 +24,22 @@
 #include "precompiled.hpp"
 
 #include "runtime/atomic.hpp"
+#include "runtime/thread.hpp"
 #include "services/mallocSiteTable.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/mallocTracker.inline.hpp"
 #include "services/memTracker.hpp"
 
-size_t MallocMemorySummary::_snapshot[CALC_OBJ_SIZE_IN_TYPE(MallocMemorySnapshot, size_t)];
+size_t MallocMemorySummary::_counters[CALC_OBJ_SIZE_IN_TYPE(MallocMemoryCounters, size_t)];
+
+// Pick a stripe for the current thread. Allocations made before the
+// current thread is attached share stripe 0.
+int StripedMemoryCounter::current_stripe() {
+  uintptr_t key = (uintptr_t)Thread::current_or_null();
+  // Thread objects are large and aligned, so fold in higher address bits.
+  key = (key >> 6) ^ (key >> 11) ^ (key >> 17);
+  return (int)(key & (stripe_count - 1));
+}
 
 // Total malloc'd memory amount
 size_t MallocMemorySnapshot::total() const {
@@ -60,9 +70,9 @@ void MallocMemorySnapshot::make_adjustment() {
 
 
 void MallocMemorySummary::initialize() {
-  assert(sizeof(_snapshot) >= sizeof(MallocMemorySnapshot), "Sanity Check");
+  assert(sizeof(_counters) >= sizeof(MallocMemoryCounters), "Sanity Check");
   // Uses placement new operator to initialize static area.
-  ::new ((void*)_snapshot)MallocMemorySnapshot();
+  ::new ((void*)_counters)MallocMemoryCounters();
 }
 
 void MallocHeader::release() const {
@@ -28,6 +28,7 @@
 #if INCLUDE_NMT
 
 #include "memory/allocation.hpp"
+#include "memory/padded.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/nmtCommon.hpp"
@@ -39,6 +40,8 @@
  * The counters are updated atomically.
  */
 class MemoryCounter {
+  friend class StripedMemoryCounter;
+
  private:
   volatile size_t   _count;
   volatile size_t   _size;
@@ -85,12 +88,110 @@ class MemoryCounter {
 
 };
 
+/*
+ * A MemoryCounter whose values are spread over several cache-line
+ * padded stripes, selected by the current thread. Summary tracking
+ * updates these on every os::malloc()/os::free(), so a single shared
+ * counter per memory type becomes a contention point when many threads
+ * allocate the same type of memory. The totals are only computed when
+ * read. A free may update a different stripe than the matching malloc,
+ * so an individual stripe can wrap around, but the sum is exact once
+ * the updates it races with have completed.
+ * The stripes only exist in the live counters; snapshots hold the sums
+ * in plain MemoryCounters.
+ */
+class StripedMemoryCounter {
+ private:
+  struct Stripe {
+    volatile size_t _count;
+    volatile size_t _size;
+  };
+
+  enum { stripe_count = 8 };  // must be a power of 2
+
+  PaddedEnd<Stripe> _stripes[stripe_count];
+
+  DEBUG_ONLY(size_t   _peak_count;)
+  DEBUG_ONLY(size_t   _peak_size; )
+
+  static int current_stripe();
+
+  inline Stripe* stripe() { return &_stripes[current_stripe()]; }
+
+ public:
+  StripedMemoryCounter() {
+    for (int i = 0; i < stripe_count; i++) {
+      _stripes[i]._count = 0;
+      _stripes[i]._size  = 0;
+    }
+    DEBUG_ONLY(_peak_count = 0;)
+    DEBUG_ONLY(_peak_size  = 0;)
+  }
+
+  inline void allocate(size_t sz) {
+    Stripe* s = stripe();
+    Atomic::inc(&s->_count);
+    if (sz > 0) {
+      Atomic::add(sz, &s->_size);
+      DEBUG_ONLY(_peak_size = MAX2(_peak_size, size()));
+    }
+    DEBUG_ONLY(_peak_count = MAX2(_peak_count, count());)
+  }
+
+  inline void deallocate(size_t sz) {
+    Stripe* s = stripe();
+    Atomic::dec(&s->_count);
+    if (sz > 0) {
+      Atomic::sub(sz, &s->_size);
+    }
+  }
+
+  inline void resize(ssize_t sz) {
+    if (sz != 0) {
+      Atomic::add(size_t(sz), &stripe()->_size);
+      DEBUG_ONLY(_peak_size = MAX2(size(), _peak_size);)
+    }
+  }
+
+  // The stripes are read one at a time, so a sum taken while other threads
+  // update them can see a free without its malloc. Sum them as signed
+  // values and report such transiently negative totals as 0.
+  inline size_t count() const {
+    ssize_t total = 0;
+    for (int i = 0; i < stripe_count; i++) {
+      total += (ssize_t)_stripes[i]._count;
+    }
+    return (size_t)MAX2(total, (ssize_t)0);
+  }
+
+  inline size_t size() const {
+    ssize_t total = 0;
+    for (int i = 0; i < stripe_count; i++) {
+      total += (ssize_t)_stripes[i]._size;
+    }
+    return (size_t)MAX2(total, (ssize_t)0);
+  }
+
+  DEBUG_ONLY(inline size_t peak_count() const { return _peak_count; })
+  DEBUG_ONLY(inline size_t peak_size()  const { return _peak_size; })
+
+  // Store the summed totals into a plain counter.
+  void copy_to(MemoryCounter* c) const {
+    c->_count = count();
+    c->_size  = size();
+    DEBUG_ONLY(c->_peak_count = _peak_count;)
+    DEBUG_ONLY(c->_peak_size  = _peak_size;)
+  }
+};
+
 /*
  * Malloc memory used by a particular subsystem.
  * It includes the memory acquired through os::malloc()
  * call and arena's backing memory.
  */
 class MallocMemory {
+  friend class MallocMemoryCounters;
+
  private:
   MemoryCounter _malloc;
   MemoryCounter _arena;
@@ -127,12 +228,48 @@ class MallocMemory {
   DEBUG_ONLY(inline const MemoryCounter& arena_counter()  const { return _arena;  })
 };
 
+/*
+ * The live counterpart of MallocMemory, updated by summary tracking.
+ */
+class StripedMallocMemory {
+  friend class MallocMemoryCounters;
+
+ private:
+  StripedMemoryCounter _malloc;
+  StripedMemoryCounter _arena;
+
+ public:
+  StripedMallocMemory() { }
+
+  inline void record_malloc(size_t sz) {
+    _malloc.allocate(sz);
+  }
+
+  inline void record_free(size_t sz) {
+    _malloc.deallocate(sz);
+  }
+
+  inline void record_new_arena() {
+    _arena.allocate(0);
+  }
+
+  inline void record_arena_free() {
+    _arena.deallocate(0);
+  }
+
+  inline void record_arena_size_change(ssize_t sz) {
+    _arena.resize(sz);
+  }
+};
+
 class MallocMemorySummary;
+class MallocMemoryCounters;
 
 // A snapshot of malloc'd memory, includes malloc memory
 // usage by types and memory used by tracking itself.
 class MallocMemorySnapshot : public ResourceObj {
   friend class MallocMemorySummary;
+  friend class MallocMemoryCounters;
 
  private:
   MallocMemory      _malloc[mt_number_of_types];
@@ -165,20 +302,40 @@ class MallocMemorySnapshot : public ResourceObj {
     return s->by_type(mtThreadStack)->malloc_count();
   }
 
+  // Make adjustment by subtracting chunks used by arenas
+  // from total chunks to get total free chunk size
+  void make_adjustment();
+};
+
+// The live malloc counters by type and of the tracking headers.
+// They are striped to avoid contention, copy_to() sums them up
+// into a MallocMemorySnapshot.
+class MallocMemoryCounters {
+ private:
+  StripedMallocMemory  _malloc[mt_number_of_types];
+  StripedMemoryCounter _tracking_header;
+
+ public:
+  inline StripedMallocMemory* by_type(MEMFLAGS flags) {
+    int index = NMTUtil::flag_to_index(flags);
+    return &_malloc[index];
+  }
+
+  inline StripedMemoryCounter* malloc_overhead() {
+    return &_tracking_header;
+  }
+
   void copy_to(MallocMemorySnapshot* s) {
     // Need to make sure that mtChunks don't get deallocated while the
     // copy is going on, because their size is adjusted using this
     // buffer in make_adjustment().
     ThreadCritical tc;
-    s->_tracking_header = _tracking_header;
+    _tracking_header.copy_to(&s->_tracking_header);
     for (int index = 0; index < mt_number_of_types; index ++) {
-      s->_malloc[index] = _malloc[index];
+      _malloc[index]._malloc.copy_to(&s->_malloc[index]._malloc);
+      _malloc[index]._arena.copy_to(&s->_malloc[index]._arena);
     }
   }
-
-  // Make adjustment by subtracting chunks used by arenas
-  // from total chunks to get total free chunk size
-  void make_adjustment();
 };
 
 /*
@@ -186,53 +343,53 @@ class MallocMemorySnapshot : public ResourceObj {
  */
 class MallocMemorySummary : AllStatic {
  private:
-  // Reserve memory for placement of MallocMemorySnapshot object
-  static size_t _snapshot[CALC_OBJ_SIZE_IN_TYPE(MallocMemorySnapshot, size_t)];
+  // Reserve memory for placement of MallocMemoryCounters object
+  static size_t _counters[CALC_OBJ_SIZE_IN_TYPE(MallocMemoryCounters, size_t)];
 
  public:
    static void initialize();
 
    static inline void record_malloc(size_t size, MEMFLAGS flag) {
-     as_snapshot()->by_type(flag)->record_malloc(size);
+     as_counters()->by_type(flag)->record_malloc(size);
    }
 
    static inline void record_free(size_t size, MEMFLAGS flag) {
-     as_snapshot()->by_type(flag)->record_free(size);
+     as_counters()->by_type(flag)->record_free(size);
    }
 
    static inline void record_new_arena(MEMFLAGS flag) {
-     as_snapshot()->by_type(flag)->record_new_arena();
+     as_counters()->by_type(flag)->record_new_arena();
    }
 
    static inline void record_arena_free(MEMFLAGS flag) {
-     as_snapshot()->by_type(flag)->record_arena_free();
+     as_counters()->by_type(flag)->record_arena_free();
    }
 
    static inline void record_arena_size_change(ssize_t size, MEMFLAGS flag) {
-     as_snapshot()->by_type(flag)->record_arena_size_change(size);
+     as_counters()->by_type(flag)->record_arena_size_change(size);
    }
 
    static void snapshot(MallocMemorySnapshot* s) {
-     as_snapshot()->copy_to(s);
+     as_counters()->copy_to(s);
      s->make_adjustment();
    }
 
    // Record memory used by malloc tracking header
    static inline void record_new_malloc_header(size_t sz) {
-     as_snapshot()->malloc_overhead()->allocate(sz);
+     as_counters()->malloc_overhead()->allocate(sz);
    }
 
    static inline void record_free_malloc_header(size_t sz) {
-     as_snapshot()->malloc_overhead()->deallocate(sz);
+     as_counters()->malloc_overhead()->deallocate(sz);
    }
 
    // The memory used by malloc tracking headers
    static inline size_t tracking_overhead() {
-     return as_snapshot()->malloc_overhead()->size();
+     return as_counters()->malloc_overhead()->size();
    }
 
-  static MallocMemorySnapshot* as_snapshot() {
-    return (MallocMemorySnapshot*)_snapshot;
+  static MallocMemoryCounters* as_counters() {
+    return (MallocMemoryCounters*)_counters;
   }
 };
 
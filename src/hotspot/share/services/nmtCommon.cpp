@@ -46,6 +46,7 @@ const char* NMTUtil::_memory_type_names[] = {
   "Module",
   "Synchronizer",
   "Safepoint",
+  "GC Card Set",
   "Unknown"
 };
 
@@ -58,6 +58,16 @@ void Events::print_all(outputStream* out) {
   }
 }
 
+void Events::print_all(outputStream* out, const char* log_name, int max) {
+  EventLog* log = _logs;
+  while (log != NULL) {
+    if (log_name == NULL || strstr(log->name(), log_name) != NULL) {
+      log->print_log_on(out, max);
+    }
+    log = log->next();
+  }
+}
+
 void Events::print() {
   print_all(tty);
 }
@@ -26,7 +26,9 @@
 #define SHARE_VM_UTILITIES_EVENTS_HPP
 
 #include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/formatBuffer.hpp"
 #include "utilities/vmError.hpp"
@@ -59,7 +61,10 @@ class EventLog : public CHeapObj<mtInternal> {
   // crashes.
   EventLog();
 
-  virtual void print_log_on(outputStream* out) = 0;
+  virtual const char* name() const = 0;
+
+  // Print the newest max events of the log, all of them if max is negative.
+  virtual void print_log_on(outputStream* out, int max = -1) = 0;
 };
 
 
@@ -68,47 +73,65 @@ class EventLog : public CHeapObj<mtInternal> {
 // providing a more featureful log function if the existing copy
 // semantics aren't appropriate.  The name is used as the label of the
 // log when it is dumped during a crash.
+//
+// The ring buffer is lock-free.  Every event takes a ticket from a
+// shared counter and owns slot (ticket % length) while it is written.
+// Each slot carries a sequence number that tells readers which ticket
+// it holds and whether that event is complete, so the log can be
+// printed at any time without stopping the threads that log to it.
 template <class T> class EventLogBase : public EventLog {
   template <class X> class EventRecord : public CHeapObj<mtInternal> {
    public:
+    // 0 if the slot was never written, 2 * ticket + 1 while the event
+    // with that ticket is being written and 2 * ticket + 2 after it.
+    volatile size_t seq;
     double  timestamp;
     Thread* thread;
     X       data;
+
+    EventRecord() : seq(0), timestamp(0.0), thread(NULL) {}
   };
 
  protected:
-  Mutex           _mutex;
   const char*     _name;
   int             _length;
-  int             _index;
-  int             _count;
+  volatile size_t _next;      // Ticket of the next event
   EventRecord<T>* _records;
 
  public:
   EventLogBase<T>(const char* name, int length = LogEventsBufferEntries):
     _name(name),
     _length(length),
-    _count(0),
-    _index(0),
-    _mutex(Mutex::event, name, false, Monitor::_safepoint_check_never) {
+    _next(0) {
     _records = new EventRecord<T>[length];
   }
 
+  const char* name() const { return _name; }
+
   double fetch_timestamp() {
     return os::elapsedTime();
   }
 
-  // move the ring buffer to next open slot and return the index of
-  // the slot to use for the current message.  Should only be called
-  // while mutex is held.
-  int compute_log_index() {
-    int index = _index;
-    if (_count < _length) _count++;
-    _index++;
-    if (_index >= _length) _index = 0;
+  // Take the next ticket and return the index of its slot, or -1 if the
+  // event has to be dropped because a thread that lapped the ring buffer
+  // is still writing the slot.  The slot must be released with
+  // commit_log_index once the record is written.
+  int claim_log_index(size_t* ticket) {
+    size_t t = Atomic::add((size_t)1, &_next) - 1;
+    int index = (int)(t % (size_t)_length);
+    size_t seq = OrderAccess::load_acquire(&_records[index].seq);
+    if ((seq & 1) != 0 || seq > 2 * t ||
+        Atomic::cmpxchg(2 * t + 1, &_records[index].seq, seq) != seq) {
+      return -1;
+    }
+    *ticket = t;
     return index;
   }
 
+  void commit_log_index(int index, size_t ticket) {
+    OrderAccess::release_store(&_records[index].seq, 2 * ticket + 2);
+  }
+
   bool should_log() {
     // Don't bother adding new entries when we're crashing.  This also
     // avoids mutating the ring buffer when printing the log.
@@ -116,15 +139,17 @@ template <class T> class EventLogBase : public EventLog {
   }
 
   // Print the contents of the log
-  void print_log_on(outputStream* out);
+  void print_log_on(outputStream* out, int max = -1);
 
  private:
-  void print_log_impl(outputStream* out);
-
   // Print a single element.  A templated implementation might need to
   // be declared by subclasses.
   void print(outputStream* out, T& e);
 
+  // Copy a single element out of the ring buffer while it may be
+  // concurrently overwritten.  The copy must be usable even if torn.
+  void copy(T& dst, T& src);
+
   void print(outputStream* out, EventRecord<T>& e) {
     out->print("Event: %.3f ", e.timestamp);
     if (e.thread != NULL) {
@@ -151,11 +176,13 @@ class FormatStringEventLog : public EventLogBase< FormatStringLogMessage<bufsz>
     if (!this->should_log()) return;
 
     double timestamp = this->fetch_timestamp();
-    MutexLockerEx ml(&this->_mutex, Mutex::_no_safepoint_check_flag);
-    int index = this->compute_log_index();
+    size_t ticket;
+    int index = this->claim_log_index(&ticket);
+    if (index < 0) return;
     this->_records[index].thread = thread;
     this->_records[index].timestamp = timestamp;
     this->_records[index].data.printv(format, ap);
+    this->commit_log_index(index, ticket);
   }
 
   void log(Thread* thread, const char* format, ...) ATTRIBUTE_PRINTF(3, 4) {
@@ -193,6 +220,10 @@ class Events : AllStatic {
  public:
   static void print_all(outputStream* out);
 
+  // Print the newest max events, all if max is negative, of the logs
+  // whose name contains log_name, of all logs if log_name is NULL.
+  static void print_all(outputStream* out, const char* log_name, int max);
+
   // Dump all events to the tty
   static void print();
 
@@ -247,38 +278,41 @@ inline void Events::log_deopt_message(Thread* thread, const char* format, ...) {
 }
 
 
+// Dump the ring buffer entries that currently have complete events,
+// oldest first.  Needs no lock, so it is safe to call while crashing
+// and while other threads keep logging.
 template <class T>
-inline void EventLogBase<T>::print_log_on(outputStream* out) {
-  if (Thread::current_or_null() == NULL) {
-    // Not yet attached? Don't try to use locking
-    print_log_impl(out);
-  } else {
-    MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
-    print_log_impl(out);
+inline void EventLogBase<T>::print_log_on(outputStream* out, int max) {
+  size_t next = OrderAccess::load_acquire(&_next);
+  size_t count = MIN2(next, (size_t)_length);
+  if (max >= 0) {
+    count = MIN2(count, (size_t)max);
   }
-}
-
-// Dump the ring buffer entries that current have entries.
-template <class T>
-inline void EventLogBase<T>::print_log_impl(outputStream* out) {
-  out->print_cr("%s (%d events):", _name, _count);
-  if (_count == 0) {
+  out->print_cr("%s (" SIZE_FORMAT " events):", _name, count);
+  if (count == 0) {
     out->print_cr("No events");
     out->cr();
     return;
   }
 
-  if (_count < _length) {
-    for (int i = 0; i < _count; i++) {
-      print(out, _records[i]);
+  for (size_t t = next - count; t < next; t++) {
+    EventRecord<T>& r = _records[t % (size_t)_length];
+    if (OrderAccess::load_acquire(&r.seq) != 2 * t + 2) {
+      // Still being written, or already replaced by a newer event.
+      continue;
     }
-  } else {
-    for (int i = _index; i < _length; i++) {
-      print(out, _records[i]);
-    }
-    for (int i = 0; i < _index; i++) {
-      print(out, _records[i]);
+    // Copy the record and print the copy only if the slot still holds the
+    // same event afterwards, so a record overwritten meanwhile is skipped
+    // rather than printed torn.
+    EventRecord<T> e;
+    e.timestamp = r.timestamp;
+    e.thread = r.thread;
+    copy(e.data, r.data);
+    OrderAccess::loadload();
+    if (OrderAccess::load_acquire(&r.seq) != 2 * t + 2) {
+      continue;
     }
+    print(out, e);
   }
   out->cr();
 }
@@ -297,6 +331,20 @@ inline void EventLogBase<ExtendedStringLogMessage>::print(outputStream* out, Ext
   out->cr();
 }
 
+// Implement a copy routine for the StringLogMessage
+template <>
+inline void EventLogBase<StringLogMessage>::copy(StringLogMessage& dst, StringLogMessage& src) {
+  memcpy(dst.buffer(), src.buffer(), dst.size() - 1);
+  dst.buffer()[dst.size() - 1] = '\0';
+}
+
+// Implement a copy routine for the ExtendedStringLogMessage
+template <>
+inline void EventLogBase<ExtendedStringLogMessage>::copy(ExtendedStringLogMessage& dst, ExtendedStringLogMessage& src) {
+  memcpy(dst.buffer(), src.buffer(), dst.size() - 1);
+  dst.buffer()[dst.size() - 1] = '\0';
+}
+
 // Place markers for the beginning and end up of a set of events.
 // These end up in the default log.
 class EventMark : public StackObj {
@@ -84,6 +84,18 @@ static jboolean _have_classpath = JNI_FALSE;
 static const char *_fVersion;
 static jboolean _wc_enabled = JNI_FALSE;
 
+/*
+ * Time spent in the launcher phases, in micro seconds, printed to stderr
+ * just before the main method is invoked if _JAVA_LAUNCHER_TIMING is set.
+ */
+static jboolean _timing_enabled = JNI_FALSE;
+static jlong _launch_start;
+static jlong _select_version_time;
+static jlong _classpath_time;
+static jlong _load_jvm_time;
+static jlong _create_jvm_time;
+static jlong _main_class_time;
+
 /*
  * Entries for splash screen environment variables.
  * putenv is performed in SelectVersion. We need
@@ -130,6 +142,7 @@ static jboolean ValidateModules(JNIEnv* env);
 static void SetPaths(int argc, char **argv);
 
 static void DumpState();
+static void PrintLauncherTiming();
 
 enum OptionKind {
     LAUNCHER_OPTION = 0,
@@ -245,6 +258,8 @@ JLI_Launch(int argc, char ** argv,              /* main argc, argv */
     _program_name = pname;
     _is_java_args = javaargs;
     _wc_enabled = cpwildcard;
+    _timing_enabled = (getenv(JLTIMING_ENV_ENTRY) != NULL);
+    _launch_start = CounterGet();
 
     InitLauncher(javaw);
     DumpState();
@@ -271,7 +286,9 @@ JLI_Launch(int argc, char ** argv,              /* main argc, argv */
      *     the pre 1.9 JRE [ 1.6 thru 1.8 ], it is as if 1.9+ has been
      *     invoked from the command line.
      */
+    start = CounterGet();
     SelectVersion(argc, argv, &main_class);
+    _select_version_time = Counter2Micros(CounterGet() - start);
 
     CreateExecutionEnvironment(&argc, &argv,
                                jrepath, sizeof(jrepath),
@@ -285,20 +302,17 @@ JLI_Launch(int argc, char ** argv,              /* main argc, argv */
     ifn.CreateJavaVM = 0;
     ifn.GetDefaultJavaVMInitArgs = 0;
 
-    if (JLI_IsTraceLauncher()) {
-        start = CounterGet();
-    }
+    start = CounterGet();
 
     if (!LoadJavaVM(jvmpath, &ifn)) {
         return(6);
     }
 
-    if (JLI_IsTraceLauncher()) {
-        end   = CounterGet();
-    }
+    end   = CounterGet();
+    _load_jvm_time = Counter2Micros(end-start);
 
     JLI_TraceLauncher("%ld micro seconds to LoadJavaVM\n",
-             (long)(jint)Counter2Micros(end-start));
+             (long)(jint)_load_jvm_time);
 
     ++argv;
     --argc;
@@ -415,6 +429,7 @@ JavaMain(void* _args)
         JLI_ReportErrorMessage(JVM_ERROR1);
         exit(1);
     }
+    _create_jvm_time = Counter2Micros(CounterGet() - start);
 
     if (showSettings != NULL) {
         ShowSettings(env, showSettings);
@@ -505,8 +520,10 @@ JavaMain(void* _args)
      * This method also correctly handles launching existing JavaFX
      * applications that may or may not have a Main-Class manifest entry.
      */
+    start = CounterGet();
     mainClass = LoadMainClass(env, mode, what);
     CHECK_EXCEPTION_NULL_LEAVE(mainClass);
+    _main_class_time = Counter2Micros(CounterGet() - start);
     /*
      * In some cases when launching an application that needs a helper, e.g., a
      * JavaFX application with no main method, the mainClass will not be the
@@ -545,6 +562,10 @@ JavaMain(void* _args)
                                        "([Ljava/lang/String;)V");
     CHECK_EXCEPTION_NULL_LEAVE(mainID);
 
+    if (_timing_enabled) {
+        PrintLauncherTiming();
+    }
+
     /* Invoke main method. */
     (*env)->CallStaticVoidMethod(env, mainClass, mainID, mainArgs);
 
@@ -969,6 +990,7 @@ SetClassPath(const char *s)
 {
     char *def;
     const char *orig = s;
+    jlong start;
     static const char format[] = "-Djava.class.path=%s";
     /*
      * usually we should not get a null pointer, but there are cases where
@@ -977,7 +999,9 @@ SetClassPath(const char *s)
      */
     if (s == NULL)
         return;
+    start = CounterGet();
     s = JLI_WildcardExpandClasspath(s);
+    _classpath_time += Counter2Micros(CounterGet() - start);
     if (sizeof(format) - 2 + JLI_StrLen(s) < JLI_StrLen(s))
         // s is became corrupted after expanding wildcards
         return;
@@ -2369,6 +2393,19 @@ DumpState()
     printf("\tfullversion:%s\n", GetFullVersion());
 }
 
+static void
+PrintLauncherTiming()
+{
+    jlong total = Counter2Micros(CounterGet() - _launch_start);
+    fprintf(stderr, "Launcher timing (micro seconds):\n");
+    fprintf(stderr, "\tmanifest and version selection: %ld\n", (long)_select_version_time);
+    fprintf(stderr, "\tclass path wildcard expansion: %ld\n", (long)_classpath_time);
+    fprintf(stderr, "\tLoadJavaVM: %ld\n", (long)_load_jvm_time);
+    fprintf(stderr, "\tCreateJavaVM: %ld\n", (long)_create_jvm_time);
+    fprintf(stderr, "\tmain class load: %ld\n", (long)_main_class_time);
+    fprintf(stderr, "\ttotal until main: %ld\n", (long)total);
+}
+
 /*
  * A utility procedure to always print to stderr
  */
@@ -39,6 +39,7 @@
 #endif
 
 #define JLDEBUG_ENV_ENTRY "_JAVA_LAUNCHER_DEBUG"
+#define JLTIMING_ENV_ENTRY "_JAVA_LAUNCHER_TIMING"
 
 JNIEXPORT void * JNICALL
 JLI_MemAlloc(size_t size);
@@ -299,6 +299,20 @@ find_positions(int fd, Byte *eb, jlong* base_offset, jlong* censtart)
 #define BUFSIZE (3 * 65536 + CENHDR + SIGSIZ)
 #define MINREAD 1024
 
+/*
+ * Size of the next read from the Central Directory, given the size of the
+ * previous one and the number of bytes already in the buffer.  Doubling
+ * on every refill keeps the first read small for the common case, yet
+ * finds a manifest deep in a large Central Directory in a few reads
+ * rather than one per MINREAD bytes, which matters on network file systems.
+ */
+static int
+next_read_size(int previous, int bytes)
+{
+    int size = previous * 2;
+    return (size < BUFSIZE - bytes) ? size : BUFSIZE - bytes;
+}
+
 /*
  * Locate the manifest file with the zip/jar file.
  *
@@ -333,6 +347,7 @@ find_file(int fd, zentry *entry, const char *file_name)
     int     res;
     int     entry_size;
     int     read_size;
+    int     chunk = MINREAD;
 
     /*
      * The (imaginary) position within the file relative to which
@@ -392,7 +407,8 @@ find_file(int fd, zentry *entry, const char *file_name)
          */
         if (bytes < CENHDR) {
             p = memmove(bp, p, bytes);
-            if ((res = read(fd, bp + bytes, MINREAD)) <= 0) {
+            chunk = next_read_size(chunk, bytes);
+            if ((res = read(fd, bp + bytes, chunk)) <= 0) {
                 free(buffer);
                 return (-1);
             }
@@ -403,7 +419,8 @@ find_file(int fd, zentry *entry, const char *file_name)
             if (p != bp)
                 p = memmove(bp, p, bytes);
             read_size = entry_size - bytes + SIGSIZ;
-            read_size = (read_size < MINREAD) ? MINREAD : read_size;
+            chunk = next_read_size(chunk, bytes);
+            read_size = (read_size < chunk) ? chunk : read_size;
             if ((res = read(fd, bp + bytes,  read_size)) <= 0) {
                 free(buffer);
                 return (-1);
@@ -45,7 +45,10 @@
 
 /* Fast modular reduction for p384 = 2^384 - 2^128 - 2^96 + 2^32 - 1.  a can be r.
  * Uses algorithm 2.30 from Hankerson, Menezes, Vanstone. Guide to
- * Elliptic Curve Cryptography. */
+ * Elliptic Curve Cryptography.
+ * This is not constant-time: inputs of other sizes and the final
+ * correction go through the variable-time mp_mod, as in the rest of
+ * the mpi based field arithmetic. */
 mp_err
 ec_GFp_nistp384_mod(const mp_int *a, mp_int *r, const GFMethod *meth)
 {
@@ -55,6 +55,7 @@
 inline bool jar::deflate_bytes(bytes& head, bytes& tail) {
   return false;
 }
+inline void jar::free_deflater() { }
 inline uint jar::get_crc32(uint c, uchar *ptr, uint len) { return 0; }
 #define Z_NULL NULL
 
@@ -81,6 +82,12 @@ inline uint jar::get_crc32(uint c, uchar *ptr, uint len) { return crc32(c, ptr,
 
 static const ushort jarmagic[2] = { SWAP_BYTES(0xCAFE), 0 };
 
+void jar::free() {
+  central_directory.free();
+  deflated.free();
+  free_deflater();
+}
+
 void jar::init(unpacker* u_) {
   BYTES_OF(*this).clear();
   u = u_;
@@ -351,6 +358,9 @@ void jar::openJarFile(const char* fname) {
       fprintf(u->errstrm, "Error: Could not open jar file: %s\n",fname);
       exit(3); // Called only from the native standalone unpacker
     }
+    // Entries are written in many small pieces (headers, names, data);
+    // use a larger stdio buffer to cut down on write system calls.
+    setvbuf(jarfp, null, _IOFBF, JAR_OUTPUT_BUFSIZE);
   }
 }
 
@@ -460,14 +470,22 @@ uLong jar::get_dostime(int modtime) {
 bool jar::deflate_bytes(bytes& head, bytes& tail) {
   int len = (int)(head.len + tail.len);
 
-  z_stream zs;
-  BYTES_OF(zs).clear();
+  // The deflater state (zlib hash tables and window, a few hundred Kb)
+  // is set up once and reset between entries, rather than being
+  // allocated and torn down again for every file in the archive.
+  int error;
+  if (zstream == null) {
+    zstream = NEW(z_stream, 1);
+    if (zstream == null)  return false;  // must_malloc has aborted
 
-  // NOTE: the window size should always be -MAX_WBITS normally -15.
-  // unzip/zipup.c and java/Deflater.c
+    // NOTE: the window size should always be -MAX_WBITS normally -15.
+    // unzip/zipup.c and java/Deflater.c
 
-  int error = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
-                           -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    error = deflateInit2((z_stream*) zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                         -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+  } else {
+    error = deflateReset((z_stream*) zstream);
+  }
   if (error != Z_OK) {
     switch (error) {
     case Z_MEM_ERROR:
@@ -482,8 +500,10 @@ bool jar::deflate_bytes(bytes& head, bytes& tail) {
     default:
       PRINTCR((2,"Error: Internal deflate error error = %d\n", error));
     }
+    free_deflater();
     return false;
   }
+  z_stream& zs = *(z_stream*) zstream;
 
   deflated.empty();
   zs.next_out  = (uchar*) deflated.grow(add_size(len, (len/2)));
@@ -516,19 +536,25 @@ bool jar::deflate_bytes(bytes& head, bytes& tail) {
       // Even if compressed size is bigger than uncompressed, write it
       PRINTCR((2, "deflate compressed data %d -> %d\n", len, zs.total_out));
       deflated.b.len = zs.total_out;
-      deflateEnd(&zs);
       return true;
     }
     PRINTCR((2, "deflate expanded data %d -> %d\n", len, zs.total_out));
-    deflateEnd(&zs);
     return false;
   }
 
-  deflateEnd(&zs);
   PRINTCR((2, "Error: deflate error deflate did not finish error=%d\n",error));
   return false;
 }
 
+void jar::free_deflater() {
+  if (zstream != null) {
+    deflateEnd((z_stream*) zstream);
+    mtrace('f', zstream, 0);
+    ::free(zstream);
+    zstream = null;
+  }
+}
+
 // Callback for fetching data from a GZIP input stream
 static jlong read_input_via_gzip(unpacker* u,
                                   void* buf, jlong minlen, jlong maxlen) {
@@ -29,6 +29,9 @@
 
 struct unpacker;
 
+// stdio buffer size for the output jar file
+#define JAR_OUTPUT_BUFSIZE (1 << 16)
+
 struct jar {
   // JAR file writer
   FILE*       jarfp;
@@ -45,6 +48,7 @@ struct jar {
   uint        central_directory_count;
   uint        output_file_offset;
   fillbytes   deflated;  // temporary buffer
+  void*       zstream;   // deflater state, reused across entries
 
   // pointer to outer unpacker, for error checks etc.
   unpacker* u;
@@ -59,10 +63,7 @@ struct jar {
 
   void init(unpacker* u_);
 
-  void free() {
-    central_directory.free();
-    deflated.free();
-  }
+  void free();
 
   void reset() {
     free();
@@ -83,6 +84,7 @@ struct jar {
 
   // The definitions of these depend on the NO_ZLIB option:
   bool deflate_bytes(bytes& head, bytes& tail);
+  void free_deflater();
   static uint get_crc32(uint c, unsigned char *ptr, uint len);
 
   // error handling
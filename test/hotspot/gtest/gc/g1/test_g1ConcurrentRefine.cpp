@@ -0,0 +1,71 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1ConcurrentRefine.hpp"
+#include "unittest.hpp"
+
+static uint wanted(size_t cur, size_t target, double rate, double time_left, double cost,
+                   double min_time_left = 0.0, uint max_threads = 8) {
+  return G1ConcurrentRefine::calc_wanted_threads(cur, target, rate, time_left, cost,
+                                                 min_time_left, max_threads);
+}
+
+TEST(G1ConcurrentRefine, no_prediction) {
+  ASSERT_EQ(0u, wanted(1000, 10, 10.0, 100.0, 0.0));
+}
+
+TEST(G1ConcurrentRefine, below_target) {
+  // 10 buffers now, 20 more expected, target 50
+  ASSERT_EQ(0u, wanted(10, 50, 0.2, 100.0, 1.0));
+  ASSERT_EQ(0u, wanted(50, 50, 0.0, 100.0, 1.0));
+}
+
+TEST(G1ConcurrentRefine, threads_for_backlog) {
+  // 100 buffers over the target to refine in 100ms at 1ms per buffer
+  ASSERT_EQ(1u, wanted(110, 10, 0.0, 100.0, 1.0));
+  // 101 buffers over the target need a second thread
+  ASSERT_EQ(2u, wanted(111, 10, 0.0, 100.0, 1.0));
+  // 400 buffers over the target at 0.5ms per buffer
+  ASSERT_EQ(2u, wanted(410, 10, 0.0, 100.0, 0.5));
+}
+
+TEST(G1ConcurrentRefine, threads_for_incoming) {
+  // 5 buffers per ms for 100ms at 1ms per buffer: 5 threads to keep up
+  ASSERT_EQ(5u, wanted(0, 0, 5.0, 100.0, 1.0));
+  // Incoming buffers and the current backlog add up
+  ASSERT_EQ(6u, wanted(100, 0, 5.0, 100.0, 1.0));
+}
+
+TEST(G1ConcurrentRefine, limited_by_max_threads) {
+  ASSERT_EQ(8u, wanted(100000, 10, 100.0, 100.0, 1.0));
+  ASSERT_EQ(3u, wanted(100000, 10, 100.0, 100.0, 1.0, 0.0, 3));
+  ASSERT_EQ(0u, wanted(100000, 10, 100.0, 100.0, 1.0, 0.0, 0));
+}
+
+TEST(G1ConcurrentRefine, min_time_left) {
+  // An overdue pause does not ask for all threads
+  ASSERT_EQ(8u, wanted(200, 0, 0.0, 1.0, 1.0));
+  ASSERT_EQ(2u, wanted(200, 0, 0.0, 1.0, 1.0, 100.0));
+  ASSERT_EQ(2u, wanted(200, 0, 0.0, 0.0, 1.0, 100.0));
+}
@@ -0,0 +1,111 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "services/mallocTracker.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "../utilities/utilitiesHelper.inline.hpp"
+
+static const int    num_threads = 4;
+static const int    num_ops     = 100000;
+static const size_t op_size     = 24;
+
+static const size_t max_count = num_threads * num_ops;
+static const size_t max_size  = max_count * op_size;
+
+class StripedCounterThread : public JavaTestThread {
+  StripedMemoryCounter* _counter;
+  bool _allocate;
+public:
+  StripedCounterThread(Semaphore* post, StripedMemoryCounter* counter, bool allocate)
+    : JavaTestThread(post), _counter(counter), _allocate(allocate) {}
+  virtual ~StripedCounterThread() {}
+
+  void main_run() {
+    for (int i = 0; i < num_ops; i++) {
+      if (_allocate) {
+        _counter->allocate(op_size);
+      } else {
+        _counter->deallocate(op_size);
+      }
+    }
+  }
+};
+
+class StripedCounterRunner : public JavaTestThread {
+  StripedMemoryCounter _counter;
+
+  // Start the allocating and freeing threads and read the totals while
+  // they run. The totals must never wrap around to huge values.
+  void run_threads(int allocating, int freeing) {
+    Semaphore done;
+    for (int i = 0; i < allocating; i++) {
+      (new StripedCounterThread(&done, &_counter, true))->doit();
+    }
+    for (int i = 0; i < freeing; i++) {
+      (new StripedCounterThread(&done, &_counter, false))->doit();
+    }
+    int running = allocating + freeing;
+    while (running > 0) {
+      ASSERT_LE(_counter.count(), max_count);
+      ASSERT_LE(_counter.size(), max_size);
+      if (done.trywait()) {
+        running--;
+      }
+    }
+  }
+
+public:
+  StripedCounterRunner(Semaphore* post) : JavaTestThread(post) {}
+  virtual ~StripedCounterRunner() {}
+
+  void main_run() {
+    // Allocations from several threads add up.
+    run_threads(num_threads, 0);
+    EXPECT_EQ(max_count, _counter.count());
+    EXPECT_EQ(max_size, _counter.size());
+
+    // Frees from other threads, which mostly update other stripes than
+    // the matching allocations, bring the totals back to zero.
+    run_threads(0, num_threads);
+    EXPECT_EQ(0u, _counter.count());
+    EXPECT_EQ(0u, _counter.size());
+
+    // Concurrent allocations and frees: the totals may be transiently
+    // negative and must then read as 0, not wrap around.
+    run_threads(num_threads, num_threads);
+    EXPECT_EQ(0u, _counter.count());
+    EXPECT_EQ(0u, _counter.size());
+
+    // Snapshots hold the sums.
+    _counter.allocate(op_size);
+    MemoryCounter copy;
+    _counter.copy_to(&copy);
+    EXPECT_EQ(1u, copy.count());
+    EXPECT_EQ(op_size, copy.size());
+  }
+};
+
+TEST_VM(StripedMemoryCounter, concurrent_updates) {
+  mt_test_doer<StripedCounterRunner>();
+}
@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "runtime/perfMemory.hpp"
 #include "unittest.hpp"
+#include "../utilities/utilitiesHelper.inline.hpp"
 
 class PerfMemoryTest : public ::testing::Test {
   public:
@@ -41,3 +42,85 @@ TEST_VM_F(PerfMemoryTest, destroy) {
   ASSERT_NE(PerfMemory::capacity(), (size_t)0) << "PerfMemory::_capacity should not be 0";
 }
 
+
+TEST(PerfMemory, copy_sampled) {
+  PerfDataPrologue prologue;
+  memset(&prologue, 0, sizeof(prologue));
+  jlong values[2] = { 1, 2 };
+  jlong copy[2] = { 0, 0 };
+
+  ASSERT_TRUE(PerfMemory::copy_sampled(&prologue, copy, values, sizeof(values), 1));
+  EXPECT_EQ(1, copy[0]);
+  EXPECT_EQ(2, copy[1]);
+
+  // No copy while an update is in progress.
+  PerfMemory::begin_sample_update(&prologue);
+  values[0] = 3;
+  EXPECT_FALSE(PerfMemory::copy_sampled(&prologue, copy, values, sizeof(values), 10));
+  values[1] = 4;
+  PerfMemory::end_sample_update(&prologue);
+
+  ASSERT_TRUE(PerfMemory::copy_sampled(&prologue, copy, values, sizeof(values), 1));
+  EXPECT_EQ(3, copy[0]);
+  EXPECT_EQ(4, copy[1]);
+}
+
+static const int num_sampled_values = 8;
+static const jlong num_sample_updates = 200000;
+
+class SampleWriterThread : public JavaTestThread {
+  PerfDataPrologue* _prologue;
+  volatile jlong* _values;
+public:
+  SampleWriterThread(Semaphore* post, PerfDataPrologue* prologue, volatile jlong* values)
+    : JavaTestThread(post), _prologue(prologue), _values(values) {}
+  virtual ~SampleWriterThread() {}
+
+  void main_run() {
+    for (jlong i = 1; i <= num_sample_updates; i++) {
+      PerfMemory::begin_sample_update(_prologue);
+      for (int k = 0; k < num_sampled_values; k++) {
+        _values[k] = i;
+      }
+      PerfMemory::end_sample_update(_prologue);
+    }
+  }
+};
+
+class SampleReaderRunner : public JavaTestThread {
+public:
+  SampleReaderRunner(Semaphore* post) : JavaTestThread(post) {}
+  virtual ~SampleReaderRunner() {}
+
+  void main_run() {
+    PerfDataPrologue prologue;
+    memset(&prologue, 0, sizeof(prologue));
+    volatile jlong values[num_sampled_values] = { 0 };
+    jlong copy[num_sampled_values];
+
+    Semaphore done;
+    (new SampleWriterThread(&done, &prologue, values))->doit();
+
+    // Every copy that succeeds holds the values of a single update, and
+    // updates are seen in order.
+    jlong last = 0;
+    bool writing = true;
+    while (writing) {
+      writing = !done.trywait();
+      if (PerfMemory::copy_sampled(&prologue, copy, (const void*)values, sizeof(copy), 100)) {
+        for (int k = 0; k < num_sampled_values; k++) {
+          ASSERT_EQ(copy[0], copy[k]) << "torn copy of update " << copy[0];
+        }
+        ASSERT_GE(copy[0], last);
+        last = copy[0];
+      }
+    }
+
+    ASSERT_TRUE(PerfMemory::copy_sampled(&prologue, copy, (const void*)values, sizeof(copy), 1));
+    EXPECT_EQ(num_sample_updates, copy[0]);
+  }
+};
+
+TEST_VM(PerfMemory, copy_sampled_concurrent) {
+  mt_test_doer<SampleReaderRunner>();
+}
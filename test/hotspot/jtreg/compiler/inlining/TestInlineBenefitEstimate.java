@@ -0,0 +1,125 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary UseInlineBenefitEstimate only lets hot call sites with constant
+ *          arguments inline callees above FreqInlineSize
+ * @requires vm.compiler2.enabled
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver compiler.inlining.TestInlineBenefitEstimate
+ */
+
+package compiler.inlining;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestInlineBenefitEstimate {
+
+    public static class Launcher {
+        // 390 bytes of bytecode: above FreqInlineSize (325), and within the
+        // limit of a hot call site with four constant arguments (325 + 4 * 35).
+        static int callee(int a, int b, int c, int d) {
+            int r = 0;
+            r = r * 31 + (a ^ 21);
+            r = r * 17 + (b ^ 58);
+            r = r * 13 + (c ^ 95);
+            r = r * 7 + (d ^ 22);
+            r = r * 29 + (a ^ 59);
+            r = r * 23 + (b ^ 96);
+            r = r * 11 + (c ^ 23);
+            r = r * 19 + (d ^ 60);
+            r = r * 31 + (a ^ 97);
+            r = r * 17 + (b ^ 24);
+            r = r * 13 + (c ^ 61);
+            r = r * 7 + (d ^ 98);
+            r = r * 29 + (a ^ 25);
+            r = r * 23 + (b ^ 62);
+            r = r * 11 + (c ^ 99);
+            r = r * 19 + (d ^ 26);
+            r = r * 31 + (a ^ 63);
+            r = r * 17 + (b ^ 100);
+            r = r * 13 + (c ^ 27);
+            r = r * 7 + (d ^ 64);
+            r = r * 29 + (a ^ 101);
+            r = r * 23 + (b ^ 28);
+            r = r * 11 + (c ^ 65);
+            r = r * 19 + (d ^ 102);
+            r = r * 31 + (a ^ 29);
+            r = r * 17 + (b ^ 66);
+            r = r * 13 + (c ^ 103);
+            r = r * 7 + (d ^ 30);
+            r = r * 29 + (a ^ 67);
+            r = r * 23 + (b ^ 104);
+            r = r * 11 + (c ^ 31);
+            r = r * 19 + (d ^ 68);
+            return r;
+        }
+
+        static int constantArgs() {
+            return callee(1, 2, 3, 4);
+        }
+
+        static int variableArgs(int a, int b, int c, int d) {
+            return callee(a, b, c, d);
+        }
+
+        public static void main(String[] args) {
+            int sum = 0;
+            for (int i = 0; i < 20_000; i++) {
+                sum += constantArgs();
+                sum += variableArgs(i, i + 1, i + 2, i + 3);
+            }
+            System.out.println("sum " + sum);
+        }
+    }
+
+    static OutputAnalyzer run(String flag) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-Xbatch", "-XX:-TieredCompilation",
+            "-XX:+UnlockDiagnosticVMOptions", flag, "-XX:+PrintInlining",
+            "-XX:CompileCommand=quiet",
+            "-XX:CompileCommand=compileonly," + Launcher.class.getName() + "::constantArgs",
+            "-XX:CompileCommand=compileonly," + Launcher.class.getName() + "::variableArgs",
+            Launcher.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        String callee = "TestInlineBenefitEstimate$Launcher::callee (390 bytes)";
+
+        OutputAnalyzer output = run("-XX:+UseInlineBenefitEstimate");
+        // The call site with constant arguments inlines the callee ...
+        output.shouldMatch(java.util.regex.Pattern.quote(callee) + "\\s+inline \\(hot, freq \\d+, benefit 4\\)");
+        // ... the one with variable arguments does not.
+        output.shouldMatch(java.util.regex.Pattern.quote(callee) + "\\s+hot method too big");
+
+        output = run("-XX:-UseInlineBenefitEstimate");
+        output.shouldNotContain("benefit");
+        output.shouldMatch(java.util.regex.Pattern.quote(callee) + "\\s+hot method too big");
+    }
+}
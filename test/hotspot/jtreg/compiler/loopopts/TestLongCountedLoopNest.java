@@ -0,0 +1,306 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Loops with a long induction variable transformed into a loop nest
+ *          by UseLongCountedLoopNest compute the same results as the interpreter
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:-UseOnStackReplacement
+ *                   -XX:+UseLongCountedLoopNest
+ *                   -XX:CompileCommand=exclude,compiler.loopopts.TestLongCountedLoopNest::reference
+ *                   compiler.loopopts.TestLongCountedLoopNest
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:-UseOnStackReplacement
+ *                   -XX:+UseLongCountedLoopNest -XX:LoopStripMiningIter=0
+ *                   -XX:CompileCommand=exclude,compiler.loopopts.TestLongCountedLoopNest::reference
+ *                   compiler.loopopts.TestLongCountedLoopNest
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:-UseOnStackReplacement
+ *                   -XX:-UseLongCountedLoopNest
+ *                   -XX:CompileCommand=exclude,compiler.loopopts.TestLongCountedLoopNest::reference
+ *                   compiler.loopopts.TestLongCountedLoopNest
+ */
+
+package compiler.loopopts;
+
+import java.util.ArrayList;
+import java.util.List;
+
+public class TestLongCountedLoopNest {
+
+    // The inner int loop of the nest covers max_jint - |stride| of the long
+    // induction variable: 127 iterations for S1 and 7 for S2. Trip counts
+    // around multiples of these exercise the transitions of the outer loop.
+    static final long S1 = 1L << 24;
+    static final long S2 = (1L << 28) + 3;
+
+    static final int INNER1 = 127;
+    static final int INNER2 = 7;
+
+    static final int WARMUP = 20_000;
+
+    static long upLt(long start, long limit) {
+        long sum = 0;
+        for (long i = start; i < limit; i += S1) {
+            sum = sum * 31 + i;
+        }
+        return sum;
+    }
+
+    static long upLtOdd(long start, long limit) {
+        long sum = 0;
+        for (long i = start; i < limit; i += S2) {
+            sum = sum * 31 + i;
+        }
+        return sum;
+    }
+
+    static long downGt(long start, long limit) {
+        long sum = 0;
+        for (long i = start; i > limit; i -= S1) {
+            sum = sum * 31 + i;
+        }
+        return sum;
+    }
+
+    static long downGtOdd(long start, long limit) {
+        long sum = 0;
+        for (long i = start; i > limit; i -= S2) {
+            sum = sum * 31 + i;
+        }
+        return sum;
+    }
+
+    // The loop is left through the taken branch of the exit test, so the
+    // backedge is on the IfFalse projection.
+    static long upIfFalse(long start, long limit) {
+        long sum = 0;
+        long i = start;
+        for (;;) {
+            sum = sum * 31 + i;
+            i += S1;
+            if (i >= limit) {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    static long downIfFalse(long start, long limit) {
+        long sum = 0;
+        long i = start;
+        for (;;) {
+            sum = sum * 31 + i;
+            i -= S2;
+            if (i <= limit) {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    // The backedge is the taken branch of the exit test.
+    static long upDoWhile(long start, long limit) {
+        long sum = 0;
+        long i = start;
+        do {
+            sum = sum * 31 + i;
+            i += S1;
+        } while (i < limit);
+        return sum;
+    }
+
+    // Limits next to the ends of the long range: the last increment ends
+    // exactly at Long.MAX_VALUE / Long.MIN_VALUE.
+    static final long NEAR_MAX = Long.MAX_VALUE - S1 + 1;
+    static final long NEAR_MIN = Long.MIN_VALUE + S2 - 1;
+
+    static long upNearMax(long start, long unused) {
+        long sum = 0;
+        for (long i = start; i < NEAR_MAX; i += S1) {
+            sum = sum * 31 + i;
+        }
+        return sum;
+    }
+
+    static long downNearMin(long start, long unused) {
+        long sum = 0;
+        for (long i = start; i > NEAR_MIN; i -= S2) {
+            sum = sum * 31 + i;
+        }
+        return sum;
+    }
+
+    // limit - start overflows: the number of iterations left does not fit
+    // in a long. The loop is left early through a second exit.
+    static final long FULL_MAX = Long.MAX_VALUE - S1;
+    static final long FULL_MIN = Long.MIN_VALUE + S2;
+
+    static long upFullRange(long start, long stop) {
+        long sum = 0;
+        for (long i = start; i < FULL_MAX; i += S1) {
+            if (i > stop) {
+                break;
+            }
+            sum = sum * 31 + i;
+        }
+        return sum;
+    }
+
+    static long downFullRange(long start, long stop) {
+        long sum = 0;
+        for (long i = start; i > FULL_MIN; i -= S2) {
+            if (i < stop) {
+                break;
+            }
+            sum = sum * 31 + i;
+        }
+        return sum;
+    }
+
+    // Excluded from compilation: always runs in the interpreter.
+    static long reference(long start, long limit, long stride, boolean atLeastOnce, long stop) {
+        long sum = 0;
+        long i = start;
+        if (!atLeastOnce && !(stride > 0 ? i < limit : i > limit)) {
+            return 0;
+        }
+        do {
+            if (stride > 0 ? i > stop : i < stop) {
+                break;
+            }
+            sum = sum * 31 + i;
+            i += stride;
+        } while (stride > 0 ? i < limit : i > limit);
+        return sum;
+    }
+
+    interface Loop {
+        long run(long a, long b);
+    }
+
+    static class Case {
+        final long a;
+        final long b;
+
+        Case(long a, long b) {
+            this.a = a;
+            this.b = b;
+        }
+    }
+
+    // Loops from start with trip counts around multiples of the inner range.
+    static void addTripCounts(List<Case> cases, long start, long stride, int inner) {
+        int[] trips = { 0, 1, 2, inner - 1, inner, inner + 1, 2 * inner, 3 * inner + 5, 10 * inner - 1 };
+        for (int n : trips) {
+            cases.add(new Case(start, start + n * stride));
+            // A limit the induction variable doesn't hit exactly
+            cases.add(new Case(start, start + n * stride - stride / 3));
+        }
+    }
+
+    static List<Case> tripCountCases(long stride, int inner) {
+        List<Case> cases = new ArrayList<>();
+        long far = 20L * inner * Math.abs(stride);
+        addTripCounts(cases, 0, stride, inner);
+        addTripCounts(cases, stride > 0 ? -12345 : 12345, stride, inner);
+        addTripCounts(cases, Long.MIN_VALUE + (stride > 0 ? 17 : far), stride, inner);
+        addTripCounts(cases, Long.MAX_VALUE - (stride > 0 ? far : 17), stride, inner);
+        // Limit on the wrong side of start
+        cases.add(new Case(0, stride > 0 ? -1 : 1));
+        return cases;
+    }
+
+    static List<Case> nearEndCases(long limit, long stride, int inner) {
+        List<Case> cases = new ArrayList<>();
+        for (int n : new int[] { 1, 2, inner, inner + 1, 4 * inner + 3 }) {
+            cases.add(new Case(limit - n * stride, 0));
+            cases.add(new Case(limit - n * stride - stride / 2, 0));
+        }
+        return cases;
+    }
+
+    static List<Case> fullRangeCases(long start, long stride, int inner) {
+        List<Case> cases = new ArrayList<>();
+        for (int n : new int[] { 0, 1, inner - 1, inner, inner + 1, 5 * inner + 2 }) {
+            cases.add(new Case(start, start + n * stride));
+        }
+        return cases;
+    }
+
+    static void check(String name, Loop loop, Loop ref, List<Case> cases) {
+        for (Case c : cases) {
+            long actual = loop.run(c.a, c.b);
+            long expected = ref.run(c.a, c.b);
+            if (actual != expected) {
+                throw new RuntimeException(name + "(" + c.a + ", " + c.b + ") = " + actual +
+                                           ", interpreter: " + expected);
+            }
+        }
+    }
+
+    static void test(String name, Loop loop, Loop ref, List<Case> cases, Case warmup) {
+        check(name, loop, ref, cases);
+        for (int i = 0; i < WARMUP; i++) {
+            loop.run(warmup.a, warmup.b);
+        }
+        check(name, loop, ref, cases);
+    }
+
+    public static void main(String[] args) {
+        test("upLt", TestLongCountedLoopNest::upLt,
+             (a, b) -> reference(a, b, S1, false, Long.MAX_VALUE),
+             tripCountCases(S1, INNER1), new Case(0, 3 * S1));
+        test("upLtOdd", TestLongCountedLoopNest::upLtOdd,
+             (a, b) -> reference(a, b, S2, false, Long.MAX_VALUE),
+             tripCountCases(S2, INNER2), new Case(0, 3 * S2));
+        test("downGt", TestLongCountedLoopNest::downGt,
+             (a, b) -> reference(a, b, -S1, false, Long.MIN_VALUE),
+             tripCountCases(-S1, INNER1), new Case(0, -3 * S1));
+        test("downGtOdd", TestLongCountedLoopNest::downGtOdd,
+             (a, b) -> reference(a, b, -S2, false, Long.MIN_VALUE),
+             tripCountCases(-S2, INNER2), new Case(0, -3 * S2));
+        test("upIfFalse", TestLongCountedLoopNest::upIfFalse,
+             (a, b) -> reference(a, b, S1, true, Long.MAX_VALUE),
+             tripCountCases(S1, INNER1), new Case(0, 3 * S1));
+        test("downIfFalse", TestLongCountedLoopNest::downIfFalse,
+             (a, b) -> reference(a, b, -S2, true, Long.MIN_VALUE),
+             tripCountCases(-S2, INNER2), new Case(0, -3 * S2));
+        test("upDoWhile", TestLongCountedLoopNest::upDoWhile,
+             (a, b) -> reference(a, b, S1, true, Long.MAX_VALUE),
+             tripCountCases(S1, INNER1), new Case(0, 3 * S1));
+        test("upNearMax", TestLongCountedLoopNest::upNearMax,
+             (a, b) -> reference(a, NEAR_MAX, S1, false, Long.MAX_VALUE),
+             nearEndCases(NEAR_MAX, S1, INNER1), new Case(NEAR_MAX - 3 * S1, 0));
+        test("downNearMin", TestLongCountedLoopNest::downNearMin,
+             (a, b) -> reference(a, NEAR_MIN, -S2, false, Long.MIN_VALUE),
+             nearEndCases(NEAR_MIN, -S2, INNER2), new Case(NEAR_MIN + 3 * S2, 0));
+        test("upFullRange", TestLongCountedLoopNest::upFullRange,
+             (a, b) -> reference(a, FULL_MAX, S1, false, b),
+             fullRangeCases(Long.MIN_VALUE + 5, S1, INNER1),
+             new Case(Long.MIN_VALUE + 5, Long.MIN_VALUE + 5 + 3 * S1));
+        test("downFullRange", TestLongCountedLoopNest::downFullRange,
+             (a, b) -> reference(a, FULL_MIN, -S2, false, b),
+             fullRangeCases(Long.MAX_VALUE - 5, -S2, INNER2),
+             new Case(Long.MAX_VALUE - 5, Long.MAX_VALUE - 5 - 3 * S2));
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary UseLongCountedLoopNest turns a loop with a long induction variable
+ *          into a nest whose inner loop is an int counted loop
+ * @requires vm.compiler2.enabled & vm.debug == true
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver compiler.loopopts.TestLongCountedLoopNestTrace
+ */
+
+package compiler.loopopts;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestLongCountedLoopNestTrace {
+
+    public static class Launcher {
+        static long loop(long start, long limit) {
+            long sum = 0;
+            for (long i = start; i < limit; i += 3) {
+                sum += i;
+            }
+            return sum;
+        }
+
+        public static void main(String[] args) {
+            long sum = 0;
+            for (int i = 0; i < 20_000; i++) {
+                sum += loop(i, i + 300);
+            }
+            System.out.println("sum " + sum);
+        }
+    }
+
+    static OutputAnalyzer run(String flag) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-Xbatch", "-XX:-TieredCompilation", "-XX:-UseOnStackReplacement",
+            flag, "-XX:+TraceLoopOpts",
+            "-XX:CompileCommand=quiet",
+            "-XX:CompileCommand=compileonly," + Launcher.class.getName() + "::loop",
+            Launcher.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        OutputAnalyzer output = run("-XX:+UseLongCountedLoopNest");
+        // The long loop is turned into a nest ...
+        output.shouldMatch("LongCounted\\s+Loop: N\\d+/N\\d+");
+        // ... whose inner loop is then a counted loop.
+        output.shouldMatch("(?m)^Counted\\s+Loop: N\\d+/N\\d+ .*counted");
+
+        output = run("-XX:-UseLongCountedLoopNest");
+        output.shouldNotContain("LongCounted");
+        output.shouldNotMatch("(?m)^Counted\\s+Loop: N\\d+/N\\d+ .*counted");
+    }
+}
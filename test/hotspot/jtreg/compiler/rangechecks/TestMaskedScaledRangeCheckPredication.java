@@ -0,0 +1,272 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Range checks of masked indices and of indices scaled by a loop
+ *          invariant are predicated. A failing predicate deoptimizes and the
+ *          code throws exactly where the interpreter does.
+ * @requires vm.compiler2.enabled
+ *
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:-UseOnStackReplacement
+ *                   -XX:CompileCommand=dontinline,compiler.rangechecks.TestMaskedScaledRangeCheckPredication::*
+ *                   -XX:CompileCommand=exclude,compiler.rangechecks.TestMaskedScaledRangeCheckPredication$Interpreted::*
+ *                   compiler.rangechecks.TestMaskedScaledRangeCheckPredication
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:-UseOnStackReplacement
+ *                   -XX:-UseLoopPredicate
+ *                   -XX:CompileCommand=dontinline,compiler.rangechecks.TestMaskedScaledRangeCheckPredication::*
+ *                   -XX:CompileCommand=exclude,compiler.rangechecks.TestMaskedScaledRangeCheckPredication$Interpreted::*
+ *                   compiler.rangechecks.TestMaskedScaledRangeCheckPredication
+ */
+
+package compiler.rangechecks;
+
+public class TestMaskedScaledRangeCheckPredication {
+
+    static final int WARMUP = 20_000;
+    static final int ROUNDS = 3;
+
+    // Iteration of the last array access, to check an exception is thrown
+    // at the same point as in the interpreter.
+    static int iter;
+
+    static long masked(int[] a, int mask, int n) {
+        long sum = 0;
+        for (int i = 0; i < n; i++) {
+            iter = i;
+            sum = sum * 31 + a[i & mask];
+        }
+        return sum;
+    }
+
+    // Not a counted loop
+    static long maskedShift(int[] a, int mask, int h) {
+        long sum = 0;
+        for (; h != 0; h >>>= 1) {
+            iter = h;
+            sum = sum * 31 + a[h & mask];
+        }
+        return sum;
+    }
+
+    static long scaled(int[] a, int scale, int offset, int from, int to) {
+        long sum = 0;
+        for (int i = from; i < to; i++) {
+            iter = i;
+            sum = sum * 31 + a[i * scale + offset];
+        }
+        return sum;
+    }
+
+    static long scaledBy4(int[] a, int scale, int offset, int from, int to) {
+        long sum = 0;
+        for (int i = from; i < to; i += 4) {
+            iter = i;
+            sum = sum * 31 + a[i * scale + offset];
+        }
+        return sum;
+    }
+
+    static long scaledDown(int[] a, int scale, int offset, int from, int to) {
+        long sum = 0;
+        for (int i = from; i > to; i -= 3) {
+            iter = i;
+            sum = sum * 31 + a[i * scale + offset];
+        }
+        return sum;
+    }
+
+    // Copies of the methods above, excluded from compilation: these give
+    // the interpreter's results. They also keep the profile of the compiled
+    // methods free of exceptions so their range checks are predicated.
+    static class Interpreted {
+        static long masked(int[] a, int mask, int n) {
+            long sum = 0;
+            for (int i = 0; i < n; i++) {
+                iter = i;
+                sum = sum * 31 + a[i & mask];
+            }
+            return sum;
+        }
+
+        static long maskedShift(int[] a, int mask, int h) {
+            long sum = 0;
+            for (; h != 0; h >>>= 1) {
+                iter = h;
+                sum = sum * 31 + a[h & mask];
+            }
+            return sum;
+        }
+
+        static long scaled(int[] a, int scale, int offset, int from, int to) {
+            long sum = 0;
+            for (int i = from; i < to; i++) {
+                iter = i;
+                sum = sum * 31 + a[i * scale + offset];
+            }
+            return sum;
+        }
+
+        static long scaledBy4(int[] a, int scale, int offset, int from, int to) {
+            long sum = 0;
+            for (int i = from; i < to; i += 4) {
+                iter = i;
+                sum = sum * 31 + a[i * scale + offset];
+            }
+            return sum;
+        }
+
+        static long scaledDown(int[] a, int scale, int offset, int from, int to) {
+            long sum = 0;
+            for (int i = from; i > to; i -= 3) {
+                iter = i;
+                sum = sum * 31 + a[i * scale + offset];
+            }
+            return sum;
+        }
+    }
+
+    interface Loop {
+        long run();
+    }
+
+    // Outcome of one call: its result, or the iteration that threw.
+    static String outcome(Loop loop) {
+        iter = -1;
+        try {
+            return "returned " + loop.run();
+        } catch (ArrayIndexOutOfBoundsException e) {
+            return "threw at iteration " + iter;
+        }
+    }
+
+    static void check(String name, Loop loop, Loop ref) {
+        String expected = outcome(ref);
+        String actual = outcome(loop);
+        if (!actual.equals(expected)) {
+            throw new RuntimeException(name + ": " + actual + ", interpreter: " + expected);
+        }
+    }
+
+    static int[] array(int length) {
+        int[] a = new int[length];
+        for (int i = 0; i < length; i++) {
+            a[i] = i * 7 + 1;
+        }
+        return a;
+    }
+
+    static final int[] A16 = array(16);
+    static final int[] A64 = array(64);
+    static final int[] A0 = array(0);
+
+    static void warmup() {
+        for (int i = 0; i < WARMUP; i++) {
+            masked(A16, 15, 100);
+            maskedShift(A16, 15, 0x1234);
+            scaled(A64, 2, 1, 0, 32);
+            scaledBy4(A64, 3, 0, 0, 20);
+            scaledDown(A64, -2, 0, 0, -30);
+        }
+    }
+
+    static void testMasked() {
+        // mask u< length: the predicate holds
+        check("masked(A16, 15, 1000)", () -> masked(A16, 15, 1000), () -> Interpreted.masked(A16, 15, 1000));
+        check("masked(A16, 7, 100)", () -> masked(A16, 7, 100), () -> Interpreted.masked(A16, 7, 100));
+        check("masked(A16, 0, 100)", () -> masked(A16, 0, 100), () -> Interpreted.masked(A16, 0, 100));
+        // The predicate fails but every access is in bounds: the compiled
+        // code must deoptimize, not throw.
+        check("masked(A16, 31, 16)", () -> masked(A16, 31, 16), () -> Interpreted.masked(A16, 31, 16));
+        check("masked(A16, 16, 16)", () -> masked(A16, 16, 16), () -> Interpreted.masked(A16, 16, 16));
+        check("masked(A16, -1, 10)", () -> masked(A16, -1, 10), () -> Interpreted.masked(A16, -1, 10));
+        check("masked(A16, MIN_VALUE, 100)", () -> masked(A16, Integer.MIN_VALUE, 100),
+              () -> Interpreted.masked(A16, Integer.MIN_VALUE, 100));
+        check("masked(A0, 0, 0)", () -> masked(A0, 0, 0), () -> Interpreted.masked(A0, 0, 0));
+        // Out of bounds accesses
+        check("masked(A16, 31, 100)", () -> masked(A16, 31, 100), () -> Interpreted.masked(A16, 31, 100));
+        check("masked(A16, 16, 17)", () -> masked(A16, 16, 17), () -> Interpreted.masked(A16, 16, 17));
+        check("masked(A16, -1, 20)", () -> masked(A16, -1, 20), () -> Interpreted.masked(A16, -1, 20));
+        check("masked(A0, 0, 1)", () -> masked(A0, 0, 1), () -> Interpreted.masked(A0, 0, 1));
+
+        check("maskedShift(A16, 15, -1)", () -> maskedShift(A16, 15, -1), () -> Interpreted.maskedShift(A16, 15, -1));
+        check("maskedShift(A16, 255, 5)", () -> maskedShift(A16, 255, 5), () -> Interpreted.maskedShift(A16, 255, 5));
+        check("maskedShift(A16, -1, 0x8000)", () -> maskedShift(A16, -1, 0x8000),
+              () -> Interpreted.maskedShift(A16, -1, 0x8000));
+        check("maskedShift(A16, 31, -1)", () -> maskedShift(A16, 31, -1), () -> Interpreted.maskedShift(A16, 31, -1));
+    }
+
+    static void testScaled() {
+        check("scaled(A64, 2, 1, 0, 32)", () -> scaled(A64, 2, 1, 0, 32), () -> Interpreted.scaled(A64, 2, 1, 0, 32));
+        // Zero scale
+        check("scaled(A64, 0, 5, 0, 1000)", () -> scaled(A64, 0, 5, 0, 1000),
+              () -> Interpreted.scaled(A64, 0, 5, 0, 1000));
+        check("scaled(A64, 0, 64, 0, 10)", () -> scaled(A64, 0, 64, 0, 10),
+              () -> Interpreted.scaled(A64, 0, 64, 0, 10));
+        // Negative scales
+        check("scaled(A64, -1, 63, 0, 64)", () -> scaled(A64, -1, 63, 0, 64),
+              () -> Interpreted.scaled(A64, -1, 63, 0, 64));
+        check("scaled(A64, -3, 0, -21, 1)", () -> scaled(A64, -3, 0, -21, 1),
+              () -> Interpreted.scaled(A64, -3, 0, -21, 1));
+        check("scaled(A64, -1, 63, 0, 65)", () -> scaled(A64, -1, 63, 0, 65),
+              () -> Interpreted.scaled(A64, -1, 63, 0, 65));
+        check("scaled(A64, -3, 0, -22, 1)", () -> scaled(A64, -3, 0, -22, 1),
+              () -> Interpreted.scaled(A64, -3, 0, -22, 1));
+        // i * scale overflows int. The int index wraps back in bounds where
+        // the first or last index computed with longs is out of bounds: the
+        // predicate fails and must deoptimize.
+        check("scaled(A64, 1 << 30, 0, 4, 5)", () -> scaled(A64, 1 << 30, 0, 4, 5),
+              () -> Interpreted.scaled(A64, 1 << 30, 0, 4, 5));
+        check("scaled(A64, MIN_VALUE, 3, 2, 3)", () -> scaled(A64, Integer.MIN_VALUE, 3, 2, 3),
+              () -> Interpreted.scaled(A64, Integer.MIN_VALUE, 3, 2, 3));
+        check("scaledBy4(A64, 1 << 30, 0, 0, 12)", () -> scaledBy4(A64, 1 << 30, 0, 0, 12),
+              () -> Interpreted.scaledBy4(A64, 1 << 30, 0, 0, 12));
+        check("scaled(A64, 1 << 30, 0, 0, 5)", () -> scaled(A64, 1 << 30, 0, 0, 5),
+              () -> Interpreted.scaled(A64, 1 << 30, 0, 0, 5));
+        check("scaled(A64, 0x10000001, 0, 0, 2)", () -> scaled(A64, 0x10000001, 0, 0, 2),
+              () -> Interpreted.scaled(A64, 0x10000001, 0, 0, 2));
+        check("scaled(A64, MAX_VALUE, 1, -1, 1)", () -> scaled(A64, Integer.MAX_VALUE, 1, -1, 1),
+              () -> Interpreted.scaled(A64, Integer.MAX_VALUE, 1, -1, 1));
+
+        check("scaledBy4(A64, 3, 0, 0, 20)", () -> scaledBy4(A64, 3, 0, 0, 20),
+              () -> Interpreted.scaledBy4(A64, 3, 0, 0, 20));
+        check("scaledBy4(A64, 3, 0, 0, 23)", () -> scaledBy4(A64, 3, 0, 0, 23),
+              () -> Interpreted.scaledBy4(A64, 3, 0, 0, 23));
+
+        check("scaledDown(A64, -2, 0, 0, -33)", () -> scaledDown(A64, -2, 0, 0, -33),
+              () -> Interpreted.scaledDown(A64, -2, 0, 0, -33));
+        check("scaledDown(A64, -2, 0, 0, -36)", () -> scaledDown(A64, -2, 0, 0, -36),
+              () -> Interpreted.scaledDown(A64, -2, 0, 0, -36));
+        check("scaledDown(A64, 2, 63, 0, -100)", () -> scaledDown(A64, 2, 63, 0, -100),
+              () -> Interpreted.scaledDown(A64, 2, 63, 0, -100));
+    }
+
+    public static void main(String[] args) {
+        // A failing predicate may get the methods recompiled without it:
+        // check both versions.
+        for (int round = 0; round < ROUNDS; round++) {
+            warmup();
+            testMasked();
+            testScaled();
+        }
+    }
+}
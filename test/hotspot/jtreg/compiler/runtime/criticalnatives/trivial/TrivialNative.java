@@ -0,0 +1,104 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/* @test
+ * @summary Trivial JNI natives return correct results and let safepoints
+ *          happen between calls
+ * @requires (os.arch != "aarch64") & (os.arch != "arm")
+ * @run main/othervm/native -Xcomp -XX:+UnlockExperimentalVMOptions -XX:+TrivialJNINatives
+ *      compiler.runtime.criticalnatives.trivial.TrivialNative true
+ * @run main/othervm/native -XX:+UnlockExperimentalVMOptions -XX:+TrivialJNINatives
+ *      compiler.runtime.criticalnatives.trivial.TrivialNative true
+ * @run main/othervm/native -Xcomp
+ *      compiler.runtime.criticalnatives.trivial.TrivialNative false
+ */
+package compiler.runtime.criticalnatives.trivial;
+public class TrivialNative {
+    static {
+        System.loadLibrary("TrivialNative");
+    }
+
+    // Both have a Java_ entry, used by the interpreter, and a JavaTrivial_
+    // entry, used by the native wrapper with -XX:+TrivialJNINatives.
+    static native int add(int a, int b);
+    static native long sum(int[] a);
+    // Number of calls that went through a JavaTrivial_ entry.
+    static native int trivialCalls();
+
+    static final int ITERATIONS = 200_000;
+
+    static volatile boolean stop;
+    static volatile Object sink;
+
+    public static void main(String args[]) throws Exception {
+        boolean expectTrivial = Boolean.parseBoolean(args[0]);
+
+        // Request safepoints while the main thread is calling the natives.
+        Thread gc = new Thread(() -> {
+            while (!stop) {
+                System.gc();
+            }
+        });
+        gc.start();
+        try {
+            test();
+        } finally {
+            stop = true;
+            gc.join();
+        }
+
+        int calls = trivialCalls();
+        if (expectTrivial && calls == 0) {
+            throw new Exception("JavaTrivial_ entries were never called");
+        }
+        if (!expectTrivial && calls != 0) {
+            throw new Exception("JavaTrivial_ entries called without -XX:+TrivialJNINatives: " + calls);
+        }
+    }
+
+    private static void test() throws Exception {
+        for (int i = 0; i < ITERATIONS; i++) {
+            int r = add(i, 42);
+            if (r != i + 42) {
+                throw new Exception("add(" + i + ", 42) returned " + r);
+            }
+
+            // A fresh array each time so that a GC between calls moves it.
+            int[] a = new int[1 + (i % 16)];
+            long expected = 0;
+            for (int j = 0; j < a.length; j++) {
+                a[j] = i + j;
+                expected += a[j];
+            }
+            sink = new byte[128];
+            long s = sum(a);
+            if (s != expected) {
+                throw new Exception("sum returned " + s + ", expected " + expected);
+            }
+
+            if (i % 10_000 == 0) {
+                // A safepoint right between two calls.
+                System.gc();
+            }
+        }
+    }
+}
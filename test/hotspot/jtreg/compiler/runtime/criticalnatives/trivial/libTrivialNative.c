@@ -0,0 +1,43 @@
+#include "jni.h"
+
+static volatile jint trivial_calls = 0;
+
+JNIEXPORT jint JNICALL JavaTrivial_compiler_runtime_criticalnatives_trivial_TrivialNative_add
+  (jint a, jint b) {
+  trivial_calls++;
+  return a + b;
+}
+
+JNIEXPORT jint JNICALL Java_compiler_runtime_criticalnatives_trivial_TrivialNative_add
+  (JNIEnv* env, jclass jclazz, jint a, jint b) {
+  return a + b;
+}
+
+JNIEXPORT jlong JNICALL JavaTrivial_compiler_runtime_criticalnatives_trivial_TrivialNative_sum
+  (jint length, jint* a) {
+  jlong s = 0;
+  jint i;
+  trivial_calls++;
+  for (i = 0; i < length; i++) {
+    s += a[i];
+  }
+  return s;
+}
+
+JNIEXPORT jlong JNICALL Java_compiler_runtime_criticalnatives_trivial_TrivialNative_sum
+  (JNIEnv* env, jclass jclazz, jintArray array) {
+  jlong s = 0;
+  jint i;
+  jint length = (*env)->GetArrayLength(env, array);
+  jint* a = (*env)->GetPrimitiveArrayCritical(env, array, NULL);
+  for (i = 0; i < length; i++) {
+    s += a[i];
+  }
+  (*env)->ReleasePrimitiveArrayCritical(env, array, a, JNI_ABORT);
+  return s;
+}
+
+JNIEXPORT jint JNICALL Java_compiler_runtime_criticalnatives_trivial_TrivialNative_trivialCalls
+  (JNIEnv* env, jclass jclazz) {
+  return trivial_calls;
+}
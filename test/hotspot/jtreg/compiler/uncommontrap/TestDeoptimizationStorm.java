@@ -0,0 +1,186 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary A method that C2 keeps recompiling for the same trap reason is
+ *          detected as a deoptimization storm and not compiled by C2 for
+ *          DeoptStormWindow; first recompilations at distinct trap sites are
+ *          not counted
+ * @requires vm.compiler1.enabled & vm.compiler2.enabled & vm.hasJFR
+ * @library /test/lib /
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ *          jdk.jfr
+ *
+ * @build sun.hotspot.WhiteBox
+ * @run driver ClassFileInstaller sun.hotspot.WhiteBox
+ *                                sun.hotspot.WhiteBox$WhiteBoxPermission
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+TieredCompilation -XX:-BackgroundCompilation -XX:-UseOnStackReplacement
+ *                   -XX:DeoptStormThreshold=3 -XX:DeoptStormWindow=600000
+ *                   -XX:CompileCommand=dontinline,compiler.uncommontrap.TestDeoptimizationStorm::*
+ *                   compiler.uncommontrap.TestDeoptimizationStorm
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+TieredCompilation -XX:-BackgroundCompilation -XX:-UseOnStackReplacement
+ *                   -XX:DeoptStormThreshold=3 -XX:DeoptStormWindow=30000
+ *                   -XX:CompileCommand=dontinline,compiler.uncommontrap.TestDeoptimizationStorm::*
+ *                   compiler.uncommontrap.TestDeoptimizationStorm expire 30000
+ */
+
+package compiler.uncommontrap;
+
+import compiler.whitebox.CompilerWhiteBoxTest;
+import java.lang.reflect.Method;
+import java.util.List;
+import jdk.jfr.Recording;
+import jdk.jfr.consumer.RecordedEvent;
+import jdk.jfr.consumer.RecordedMethod;
+import jdk.test.lib.Asserts;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.jfr.Events;
+import jdk.test.lib.process.OutputAnalyzer;
+import sun.hotspot.WhiteBox;
+
+public class TestDeoptimizationStorm {
+
+    private static final WhiteBox WHITE_BOX = WhiteBox.getWhiteBox();
+
+    private static final String EVENT_NAME = "jdk.DeoptimizationStorm";
+
+    private static final int ROUNDS = 4;
+
+    private static final int[] ARRAY = new int[10];
+
+    // C2 predicates the range check of a[i] on the whole iteration range
+    // [0, n). With n > a.length and an early exit the predicate fails
+    // although every access is in bounds: the method traps for "predicate"
+    // at the same place each time, without an exception.
+    static int loop(int[] a, int n, int stop) {
+        int r = 0;
+        for (int i = 0; i < n; i++) {
+            if (i == stop) {
+                break;
+            }
+            r += a[i] + i;
+        }
+        return r;
+    }
+
+    // Each branch is never taken while profiling, so C2 replaces it with an
+    // unstable_if trap. Taking one branch per round recompiles the method
+    // once at each of several sites.
+    static int branches(int x) {
+        int r = 0;
+        if (x == 1) { r += 11; }
+        if (x == 2) { r += 22; }
+        if (x == 3) { r += 33; }
+        if (x == 4) { r += 44; }
+        if (x == 5) { r += 55; }
+        return r;
+    }
+
+    static void profileLoop() {
+        for (int i = 0; i < 20_000; i++) {
+            loop(ARRAY, ARRAY.length, (i & 1) == 0 ? 5 : ARRAY.length);
+        }
+    }
+
+    static void profileBranches() {
+        for (int i = 0; i < 20_000; i++) {
+            branches(0);
+        }
+    }
+
+    static void compileC2(Method m, Runnable profile, int round) {
+        WHITE_BOX.deoptimizeMethod(m);
+        WHITE_BOX.enqueueMethodForCompilation(m, CompilerWhiteBoxTest.COMP_LEVEL_FULL_PROFILE);
+        profile.run();
+        Asserts.assertTrue(WHITE_BOX.enqueueMethodForCompilation(m, CompilerWhiteBoxTest.COMP_LEVEL_FULL_OPTIMIZATION),
+                           "C2 compilation must be possible in round " + round);
+        Asserts.assertEQ(WHITE_BOX.getMethodCompilationLevel(m), CompilerWhiteBoxTest.COMP_LEVEL_FULL_OPTIMIZATION,
+                         m.getName() + "() must be C2 compiled in round " + round);
+    }
+
+    public static void main(String[] args) throws Exception {
+        boolean expire = args.length > 0 && args[0].equals("expire");
+        Method loop = TestDeoptimizationStorm.class.getDeclaredMethod("loop", int[].class, int.class, int.class);
+        Method branches = TestDeoptimizationStorm.class.getDeclaredMethod("branches", int.class);
+
+        try (Recording recording = new Recording()) {
+            recording.enable(EVENT_NAME);
+            recording.start();
+
+            // First recompilations at distinct sites are profile completion.
+            for (int round = 1; round <= 5; round++) {
+                compileC2(branches, TestDeoptimizationStorm::profileBranches, round);
+                Asserts.assertEQ(branches(round), round * 11, "wrong result");
+                Asserts.assertFalse(WHITE_BOX.isMethodCompiled(branches),
+                                    "branches() must have been deoptimized in round " + round);
+            }
+
+            // Repeated recompilations at the same site are a storm. The
+            // first trap is not a repeat, the next three are.
+            for (int round = 1; round <= ROUNDS; round++) {
+                compileC2(loop, TestDeoptimizationStorm::profileLoop, round);
+                Asserts.assertEQ(loop(ARRAY, 1000, ARRAY.length), 45, "wrong result");
+                Asserts.assertFalse(WHITE_BOX.isMethodCompiled(loop),
+                                    "loop() must have been deoptimized in round " + round);
+            }
+            long stormEnd = System.currentTimeMillis() + (expire ? Long.parseLong(args[1]) : 0);
+
+            recording.stop();
+
+            List<RecordedEvent> events = Events.fromRecording(recording);
+            Asserts.assertEQ(events.size(), 1, "expected exactly one " + EVENT_NAME + " event");
+            RecordedEvent event = events.get(0);
+            RecordedMethod method = event.getValue("method");
+            Asserts.assertEQ(method.getName(), "loop");
+            Asserts.assertEQ(event.getString("reason"), "predicate");
+            Asserts.assertEQ(event.getInt("recompileCount"), 3);
+            Asserts.assertTrue(event.getBoolean("pinned"), "highest tier must be disabled");
+
+            // The method stays at the profiled C1 tier during the window,
+            // but it is not made permanently not compilable by C2.
+            profileLoop();
+            Asserts.assertEQ(WHITE_BOX.getMethodCompilationLevel(loop), CompilerWhiteBoxTest.COMP_LEVEL_FULL_PROFILE,
+                             "loop() must not be C2 compiled during the storm");
+            Asserts.assertTrue(WHITE_BOX.isMethodCompilable(loop, CompilerWhiteBoxTest.COMP_LEVEL_FULL_OPTIMIZATION),
+                               "C2 must not be disabled permanently for loop()");
+
+            if (expire) {
+                long wait = stormEnd - System.currentTimeMillis() + 1000;
+                if (wait > 0) {
+                    Thread.sleep(wait);
+                }
+                profileLoop();
+                Asserts.assertEQ(WHITE_BOX.getMethodCompilationLevel(loop), CompilerWhiteBoxTest.COMP_LEVEL_FULL_OPTIMIZATION,
+                                 "loop() must be C2 compiled again after the storm window");
+            }
+        }
+
+        OutputAnalyzer output = new JMXExecutor().execute("Compiler.deopt_stats");
+        output.shouldMatch("Deoptimization storms \\(DeoptStormThreshold=3, DeoptStormWindow=[0-9]+ms\\):");
+        output.shouldMatch("predicate: 1 methods");
+        output.shouldNotMatch("unstable_if: [1-9][0-9]* methods");
+    }
+}
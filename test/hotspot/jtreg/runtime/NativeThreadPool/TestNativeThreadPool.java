@@ -0,0 +1,163 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/**
+ * @test TestNativeThreadPool
+ * @summary Java threads started on pooled native threads reuse them and
+ *          behave like threads started on fresh native threads
+ * @requires (os.family == "linux")
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run driver TestNativeThreadPool
+ */
+
+import java.lang.management.ManagementFactory;
+import java.lang.management.ThreadMXBean;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.HashSet;
+import java.util.Set;
+
+import jdk.test.lib.process.OutputAnalyzer;
+import jdk.test.lib.process.ProcessTools;
+
+public class TestNativeThreadPool {
+
+    static final int THREADS = 8;
+
+    // Each thread burns this much CPU. A thread started on the same native
+    // thread afterwards must not see it in its own CPU time.
+    static final long BURN_NANOS = 200_000_000L;
+
+    static final int[] PRIORITIES = { Thread.MIN_PRIORITY, Thread.NORM_PRIORITY, Thread.MAX_PRIORITY };
+
+    // Linux truncates native thread names to 15 characters
+    static final int NATIVE_NAME_LENGTH = 15;
+
+    static int depth;
+
+    static void recurse() {
+        depth++;
+        recurse();
+    }
+
+    // The kernel task id of the current thread
+    static String nativeTid() throws Exception {
+        Path self = Files.readSymbolicLink(Paths.get("/proc/thread-self"));
+        return self.getFileName().toString();
+    }
+
+    static String nativeName() throws Exception {
+        return new String(Files.readAllBytes(Paths.get("/proc/thread-self/comm"))).trim();
+    }
+
+    static void check(boolean condition, String message) {
+        if (!condition) {
+            throw new RuntimeException(message);
+        }
+    }
+
+    public static class Worker {
+        static volatile Throwable failure;
+        static volatile String tid;
+
+        public static void main(String[] args) throws Exception {
+            ThreadMXBean mxbean = ManagementFactory.getThreadMXBean();
+            boolean cpuTime = mxbean.isCurrentThreadCpuTimeSupported();
+            Set<String> tids = new HashSet<>();
+            int reused = 0;
+            for (int i = 0; i < THREADS; i++) {
+                String name = "PoolWorker-" + i;
+                int priority = PRIORITIES[i % PRIORITIES.length];
+                Thread t = new Thread(() -> {
+                    try {
+                        if (cpuTime) {
+                            long start = mxbean.getCurrentThreadCpuTime();
+                            check(start < BURN_NANOS / 2,
+                                  name + " starts with " + start + " ns CPU time");
+                        }
+                        check(Thread.currentThread().getPriority() == priority,
+                              name + " has priority " + Thread.currentThread().getPriority());
+                        String expected = name.length() > NATIVE_NAME_LENGTH ? name.substring(0, NATIVE_NAME_LENGTH) : name;
+                        String actual = nativeName();
+                        check(actual.equals(expected), name + " has native name " + actual);
+                        tid = nativeTid();
+
+                        // The stack guard pages must be in place on a reused native thread
+                        depth = 0;
+                        try {
+                            recurse();
+                            throw new RuntimeException("no StackOverflowError");
+                        } catch (StackOverflowError e) {
+                            // expected
+                        }
+
+                        if (cpuTime) {
+                            long end = mxbean.getCurrentThreadCpuTime() + BURN_NANOS;
+                            while (mxbean.getCurrentThreadCpuTime() < end) {
+                                // burn CPU
+                            }
+                        }
+                    } catch (Throwable e) {
+                        failure = e;
+                    }
+                }, name);
+                t.setPriority(priority);
+                t.start();
+                t.join();
+                if (failure != null) {
+                    throw new RuntimeException(failure);
+                }
+                if (!tids.add(tid)) {
+                    reused++;
+                }
+                // Give the native thread time to reach the pool
+                Thread.sleep(100);
+            }
+            System.out.println("reused native threads: " + reused);
+        }
+    }
+
+    static OutputAnalyzer run(String... args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(args);
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        OutputAnalyzer output = run("-XX:NativeThreadPoolSize=4",
+                                    "-XX:NativeThreadPoolIdleTimeout=60000",
+                                    "-Xlog:os+thread=info",
+                                    Worker.class.getName());
+        output.shouldContain("started on pooled native thread");
+        output.shouldMatch("reused native threads: [1-9]");
+
+        output = run("-XX:NativeThreadPoolSize=0",
+                     "-Xlog:os+thread=info",
+                     Worker.class.getName());
+        output.shouldNotContain("started on pooled native thread");
+        output.shouldContain("reused native threads: 0");
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import jdk.test.lib.dcmd.CommandExecutor;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.dcmd.PidJcmdExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+import org.testng.annotations.Test;
+
+/*
+ * @test
+ * @summary Test of diagnostic command Thread.top
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run testng ThreadTopTest
+ */
+public class ThreadTopTest {
+
+    static final String BUSY_THREAD = "ThreadTopTest-busy";
+
+    static volatile boolean stop;
+    static volatile long sink;
+
+    public void run(CommandExecutor executor) throws InterruptedException {
+        Thread busy = new Thread(() -> {
+            long x = 0;
+            while (!stop) {
+                x += new byte[64].length;
+            }
+            sink = x;
+        }, BUSY_THREAD);
+        stop = false;
+        busy.start();
+        try {
+            OutputAnalyzer output = executor.execute("Thread.top 50");
+            output.shouldMatch("Top \\d+ of \\d+ Java threads by CPU time:");
+            output.shouldContain("\"" + BUSY_THREAD + "\"");
+
+            output = executor.execute("Thread.top -a 50");
+            output.shouldMatch("Top \\d+ of \\d+ Java threads by allocated bytes:");
+            output.shouldContain("\"" + BUSY_THREAD + "\"");
+
+            output = executor.execute("Thread.top 0");
+            output.shouldMatch("Top 0 of \\d+ Java threads by CPU time:");
+            output.shouldNotContain("tid=");
+
+            output = executor.execute("Thread.top -1");
+            output.shouldContain("Invalid count: -1");
+        } finally {
+            stop = true;
+            busy.join();
+        }
+    }
+
+    @Test
+    public void jmx() throws InterruptedException {
+        run(new JMXExecutor());
+    }
+
+    @Test
+    public void cli() throws InterruptedException {
+        run(new PidJcmdExecutor());
+    }
+}
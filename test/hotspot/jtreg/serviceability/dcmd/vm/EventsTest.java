@@ -0,0 +1,99 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+import jdk.test.lib.dcmd.CommandExecutor;
+import jdk.test.lib.dcmd.JMXExecutor;
+import jdk.test.lib.dcmd.PidJcmdExecutor;
+import jdk.test.lib.process.OutputAnalyzer;
+import org.testng.annotations.Test;
+
+/*
+ * @test
+ * @summary Test of diagnostic command VM.events
+ * @library /test/lib
+ * @modules java.base/jdk.internal.misc
+ *          java.management
+ * @run testng EventsTest
+ */
+public class EventsTest {
+
+    // Let the VM throw, and log, a few internal exceptions.
+    static void throwInternalExceptions() {
+        for (int i = 0; i < 3; i++) {
+            try {
+                System.arraycopy(new Object[] { "x" }, 0, new Integer[1], 0, 1);
+                throw new RuntimeException("ArrayStoreException expected");
+            } catch (ArrayStoreException e) {
+                // expected
+            }
+        }
+    }
+
+    public void run(CommandExecutor executor) {
+        throwInternalExceptions();
+
+        OutputAnalyzer output = executor.execute("VM.events");
+        output.shouldMatch("(?m)^Events \\(\\d+ events\\):");
+        output.shouldMatch("Internal exceptions \\(\\d+ events\\):");
+        output.shouldMatch("Classes redefined \\(\\d+ events\\):");
+        output.shouldMatch("Deoptimization events \\(\\d+ events\\):");
+        output.shouldContain("ArrayStoreException");
+
+        output = executor.execute("VM.events log=Internal");
+        output.shouldMatch("Internal exceptions \\(\\d+ events\\):");
+        output.shouldContain("ArrayStoreException");
+        output.shouldNotContain("Classes redefined");
+        output.shouldNotContain("Deoptimization events");
+
+        output = executor.execute("VM.events log=NoSuchLog");
+        output.shouldNotContain(" events):");
+
+        output = executor.execute("VM.events max=0");
+        output.shouldMatch("Internal exceptions \\(0 events\\):");
+        output.shouldContain("No events");
+        output.shouldNotContain("Event: ");
+
+        output = executor.execute("VM.events log=Internal max=1");
+        output.shouldMatch("Internal exceptions \\(1 events\\):");
+        output.shouldMatch("Event: \\d+\\.\\d+ ");
+
+        // Negative values print all events, even the ones that do not fit
+        // in an int.
+        output = executor.execute("VM.events log=Internal max=-4294967296");
+        output.shouldNotMatch("Internal exceptions \\(0 events\\):");
+        output.shouldContain("ArrayStoreException");
+
+        output = executor.execute("VM.events log=Internal max=4294967296");
+        output.shouldNotMatch("Internal exceptions \\(0 events\\):");
+        output.shouldContain("ArrayStoreException");
+    }
+
+    @Test
+    public void jmx() {
+        run(new JMXExecutor());
+    }
+
+    @Test
+    public void cli() {
+        run(new PidJcmdExecutor());
+    }
+}
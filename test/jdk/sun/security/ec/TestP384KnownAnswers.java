@@ -0,0 +1,162 @@
+/*
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @summary Known answer tests for ECDH and ECDSA on secp384r1 (NIST P-384)
+ * @modules jdk.crypto.ec
+ * @run main TestP384KnownAnswers
+ */
+
+import java.math.BigInteger;
+import java.security.AlgorithmParameters;
+import java.security.KeyFactory;
+import java.security.PrivateKey;
+import java.security.PublicKey;
+import java.security.Signature;
+import java.security.spec.ECGenParameterSpec;
+import java.security.spec.ECParameterSpec;
+import java.security.spec.ECPoint;
+import java.security.spec.ECPrivateKeySpec;
+import java.security.spec.ECPublicKeySpec;
+import java.util.Arrays;
+import javax.crypto.KeyAgreement;
+
+/*
+ * secp384r1 uses a specialized reduction modulo p384. The vectors below
+ * were generated independently of SunEC and check the results of the
+ * field arithmetic through ECDH and ECDSA.
+ */
+public class TestP384KnownAnswers {
+
+    private static final String PROVIDER = "SunEC";
+
+    // Key pair A
+    private static final String A_PRIV =
+        "4d86ea17615af08a9a0fbb05d50161b4b775b9b5e3080c947ee3ce5222f4496991a8b732481f6fd0a6d08c5d3d853d4a";
+    private static final String A_X =
+        "69ad36d021579e9fee14712ab80b61d393b011568fab4b52d1ac363134dc72685ea44dbd2e10d39511c766242c03107f";
+    private static final String A_Y =
+        "701bdbc6c73d0f6778c9e4d7b3c085ce22c6882e16a1f021697aca2fbd619f5ef12f219007941a3562cb87bc629b76d2";
+
+    // Key pair B
+    private static final String B_PRIV =
+        "e5670591855cb16ca50ba305bd0f7ba2091b02626eb89d8cf94fd96c9dae31e3a28f492d2e3e9806a41817bdd4de710d";
+    private static final String B_X =
+        "0be512816947834464f996d8320dd02acfc7416c8de08c38b1588faa8434ecbe11477f76aaeada3fb3537c6dab0edc0f";
+    private static final String B_Y =
+        "9cc692220fed1e40d79a2530fce7664de323f6d45cb627f750ee801bd12d223ebc6b4dd3c321d2608b7813fca285f22a";
+
+    // ECDH shared secret of A and B
+    private static final String SHARED =
+        "6ac7e0f61f8180d518c3e5216209c8ddc6ad2fe38cdb2334d6dd28b5e690862be1dc7e7a6dfd232aede2a850f00045d7";
+
+    // SHA384withECDSA signature of MESSAGE with key A, DER encoded
+    private static final String MESSAGE = "P-384 known answer test";
+    private static final String SIGNATURE =
+        "306502303c685dab2f276ab90fd2826a606db47aca6ba7e5c4b0dbea231c635096f7ff444cbe91533591519bb2af32e5375108b5"
+        + "023100fe61e7c915d88e4acde3d0f66a3ef506dc2e0e2a2d5cf9ae364434fdb3d40cf0609bd10a667f0b06b72cb97ae53cb298";
+
+    private static ECParameterSpec params;
+    private static KeyFactory kf;
+
+    public static void main(String[] args) throws Exception {
+        AlgorithmParameters ap = AlgorithmParameters.getInstance("EC", PROVIDER);
+        ap.init(new ECGenParameterSpec("secp384r1"));
+        params = ap.getParameterSpec(ECParameterSpec.class);
+        kf = KeyFactory.getInstance("EC", PROVIDER);
+
+        PrivateKey privA = privateKey(A_PRIV);
+        PublicKey pubA = publicKey(A_X, A_Y);
+        PrivateKey privB = privateKey(B_PRIV);
+        PublicKey pubB = publicKey(B_X, B_Y);
+
+        // ECDH in both directions
+        checkECDH(privA, pubB, SHARED);
+        checkECDH(privB, pubA, SHARED);
+
+        // (n - 1) * Q = -Q has the same x coordinate as Q
+        PrivateKey minusOne = privateKey(params.getOrder().subtract(BigInteger.ONE).toString(16));
+        checkECDH(minusOne, pubB, B_X);
+        checkECDH(minusOne, pubA, A_X);
+
+        // ECDSA verification of a known signature
+        byte[] msg = MESSAGE.getBytes("US-ASCII");
+        if (!verify(pubA, msg, hex(SIGNATURE))) {
+            throw new RuntimeException("Known signature does not verify");
+        }
+        if (verify(pubB, msg, hex(SIGNATURE))) {
+            throw new RuntimeException("Known signature verifies with the wrong key");
+        }
+        byte[] badMsg = msg.clone();
+        badMsg[0] ^= 1;
+        if (verify(pubA, badMsg, hex(SIGNATURE))) {
+            throw new RuntimeException("Known signature verifies for the wrong message");
+        }
+
+        // ECDSA signatures made with the known keys
+        for (int i = 0; i < 10; i++) {
+            Signature s = Signature.getInstance("SHA384withECDSA", PROVIDER);
+            s.initSign(privB);
+            s.update(msg);
+            if (!verify(pubB, msg, s.sign())) {
+                throw new RuntimeException("Signature made with key B does not verify");
+            }
+        }
+    }
+
+    private static void checkECDH(PrivateKey priv, PublicKey pub, String expected)
+            throws Exception {
+        KeyAgreement ka = KeyAgreement.getInstance("ECDH", PROVIDER);
+        ka.init(priv);
+        ka.doPhase(pub, true);
+        byte[] secret = ka.generateSecret();
+        if (!Arrays.equals(secret, hex(expected))) {
+            throw new RuntimeException("ECDH mismatch: expected " + expected
+                    + ", got " + new BigInteger(1, secret).toString(16));
+        }
+    }
+
+    private static boolean verify(PublicKey pub, byte[] msg, byte[] sig) throws Exception {
+        Signature s = Signature.getInstance("SHA384withECDSA", PROVIDER);
+        s.initVerify(pub);
+        s.update(msg);
+        return s.verify(sig);
+    }
+
+    private static PrivateKey privateKey(String d) throws Exception {
+        return kf.generatePrivate(new ECPrivateKeySpec(new BigInteger(d, 16), params));
+    }
+
+    private static PublicKey publicKey(String x, String y) throws Exception {
+        ECPoint w = new ECPoint(new BigInteger(x, 16), new BigInteger(y, 16));
+        return kf.generatePublic(new ECPublicKeySpec(w, params));
+    }
+
+    private static byte[] hex(String s) {
+        byte[] b = new byte[s.length() / 2];
+        for (int i = 0; i < b.length; i++) {
+            b[i] = (byte)Integer.parseInt(s.substring(2 * i, 2 * i + 2), 16);
+        }
+        return b;
+    }
+}
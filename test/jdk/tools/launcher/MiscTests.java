@@ -121,10 +121,27 @@ public class MiscTests extends TestHelper {
         }
     }
 
+    static void testLauncherTiming() throws IOException {
+        File testJar = new File("Timing.jar");
+        createJar(testJar, "public static void main(String... args) {}");
+        final Map<String, String> envToSet = new HashMap<>();
+        envToSet.put("_JAVA_LAUNCHER_TIMING", "true");
+        TestResult tr = doExec(envToSet, javaCmd, "-jar", testJar.getName());
+        tr.checkPositive();
+        if (!tr.isOK()
+            || !tr.contains("Launcher timing")
+            || !tr.matches("\\s*manifest and version selection: \\d+$")
+            || !tr.matches("\\s*CreateJavaVM: \\d+$")
+            || !tr.matches("\\s*main class load: \\d+$")) {
+            System.out.println(tr);
+        }
+    }
+
     public static void main(String... args) throws IOException {
         testWithClassPathSetViaProperty();
         test6856415();
         testJLDEnv();
+        testLauncherTiming();
         if (testExitValue != 0) {
             throw new Error(testExitValue + " tests failed");
         }